@@ -1,6 +1,7 @@
 #include "mainwindow.h"               
 #include "./ui_mainwindow.h"            
 #include "widgets/taskcard.h"           
+#include "widgets/taskcarddelegate.h"
 #include <QHBoxLayout>                 
 #include <QVBoxLayout>                
 #include <QMenuBar>                  
@@ -21,16 +22,21 @@
 #include <QCheckBox>                  
 #include <QDebug>                     
 #include <QTextCursor>              
+#include <QProgressBar>
+#include <QStatusBar>
+#include <QTimer>
 
 // Конструктор главного окна приложения
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
-    , ui(new Ui::MainWindow) { // Инициализация пользовательского интерфейса
+    , ui(new Ui::MainWindow) // Инициализация пользовательского интерфейса
+    , cardPool([this](Task* task) { return createTaskCard(task); }) {
     ui->setupUi(this);
     setupUI();
     setupMenuBar();
     setupToolBar();
-    setWindowTitle("Скрам Доска");
+    setupSaving();
+    setWindowTitle("Скрам Доска[*]"); // [*] - отметка несохраненных изменений
     updateStatistics();
 }
 
@@ -67,6 +73,18 @@ void MainWindow::setupUI() {
     for (ColumnWidget* column : columns) {
         connect(column, &ColumnWidget::taskDropped, this, &MainWindow::onTaskDropped);
     }
+
+    // Модели и делегат виртуализированного режима (включается на больших досках)
+    cardDelegate = new TaskCardDelegate(&board, this);
+    connect(cardDelegate, &TaskCardDelegate::editClicked, this, &MainWindow::onTaskEdit);
+    connect(cardDelegate, &TaskCardDelegate::deleteClicked, this, &MainWindow::onTaskDelete);
+    connect(cardDelegate, &TaskCardDelegate::statusChangeClicked, this, &MainWindow::onTaskStatusChange);
+
+    for (auto it = columns.begin(); it != columns.end(); ++it) {
+        ColumnModel* model = new ColumnModel(&board, it.key(), this);
+        columnModels[it.key()] = model;
+        it.value()->setVirtualModel(model, cardDelegate);
+    }
     
     // Добавление колонок в основной компоновщик в порядке слева направо
     mainLayout->addWidget(columns[TaskStatus::Backlog]);
@@ -146,44 +164,156 @@ void MainWindow::setupToolBar() {
 }
 
 void MainWindow::refreshBoard() {
-    qDebug() << "refreshBoard вызван";
+    setVirtualized(board.getTasks().size() > VirtualizationThreshold);
+
+    if (virtualized) {
+        reconcileModels(); // Модели хранят только дескрипторы, отрисовываются лишь видимые строки
+    } else {
+        reconcileCards();
+    }
+
+    showWarningIfUnassigned(); // Предупреждение о неназначеннных задачах
+    updateStatistics();
+}
+
+void MainWindow::setVirtualized(bool enabled) {
+    if (virtualized == enabled) {
+        return;
+    }
+    virtualized = enabled;
+
+    if (enabled) {
+        // Карточки-виджеты больше не нужны: возвращаем их в пул (лишние удалятся) и забываем показанное
+        // (задачи карточек могли быть уже удалены при загрузке, поэтому колонку по задаче не ищем)
+        for (TaskCard* card : cards) {
+            for (ColumnWidget* column : columns) {
+                column->removeTaskCard(card);
+            }
+            cardPool.release(card);
+        }
+        cards.clear();
+    } else {
+        for (ColumnModel* model : columnModels) {
+            model->clear(); // Освобождаем строки моделей
+        }
+    }
+    reconciler.reset(); // Новый режим заполняется сверкой с нуля
 
     for (ColumnWidget* column : columns) {
-        column->clearTasks();
+        column->setVirtualized(enabled);
     }
+}
 
-    for (Task& task : board.getTasks()) {
-        qDebug() << "Обрабатываем задачу:" << task.getTitle();
-        qDebug() << "  Дедлайн есть:" << task.hasDeadline();
-        if (task.hasDeadline()) {
-            qDebug() << "  Дней до дедлайна:" << task.daysUntilDeadline();
+void MainWindow::reconcileCards() {
+    // Сверка доски с показанными карточками: виджеты трогаются только для изменившихся задач
+    const QList<CardOperation> operations = reconciler.reconcile(board, [this](const Task& task) {
+        return matchesSearch(task);
+    });
+
+    // Фаза 1: снимаем с колонок удаляемые и перемещаемые карточки
+    for (const CardOperation& op : operations) {
+        if (op.kind == CardOperation::Remove) {
+            TaskCard* card = cards.take(op.taskId);
+            if (card) {
+                columns[op.status]->removeTaskCard(card);
+                cardPool.release(card); // Карточка вернется при следующей вставке
+            }
+        } else if (op.kind == CardOperation::Move) {
+            columns[op.previousStatus]->removeTaskCard(cards.value(op.taskId));
         }
+    }
 
-        // Пропуск задач, не соответствующих поисковому запросу
-        if (!matchesSearch(&task)) {
-            continue;
+    // Фаза 2: вставки по возрастанию позиций и обновление изменившихся карточек
+    for (const CardOperation& op : operations) {
+        switch (op.kind) {
+        case CardOperation::Insert: {
+            TaskCard* card = cardPool.acquire(op.task);
+            cards.insert(op.taskId, card);
+            columns[op.status]->insertTaskCard(op.index, card);
+            break;
         }
+        case CardOperation::Move: {
+            TaskCard* card = cards.value(op.taskId);
+            card->updateDisplay();
+            columns[op.status]->insertTaskCard(op.index, card);
+            break;
+        }
+        case CardOperation::Update:
+            cards.value(op.taskId)->updateDisplay();
+            break;
+        case CardOperation::Remove:
+            break;
+        }
+    }
+}
 
-        TaskCard* card = new TaskCard(&task, &board, this); // Создание карточки для задачи
+void MainWindow::reconcileModels() {
+    // Та же сверка, что и для карточек, но операции применяются к строкам моделей колонок
+    auto filter = [this](const Task& task) { return matchesSearch(task); };
+    const QList<CardOperation> operations = reconciler.reconcile(board, filter);
 
-        connect(card, &TaskCard::editClicked, this, &MainWindow::onTaskEdit);
-        connect(card, &TaskCard::deleteClicked, this, &MainWindow::onTaskDelete);
-        connect(card, &TaskCard::statusChangeClicked, this, &MainWindow::onTaskStatusChange);
+    // Колонку с большим числом вставок и удалений (загрузка, смена фильтра) проще перечитать целиком
+    QMap<TaskStatus, int> structural;
+    for (const CardOperation& op : operations) {
+        if (op.kind == CardOperation::Move) {
+            structural[op.previousStatus]++;
+        }
+        if (op.kind != CardOperation::Update) {
+            structural[op.status]++;
+        }
+    }
+    QList<TaskStatus> resetColumns;
+    for (auto it = structural.constBegin(); it != structural.constEnd(); ++it) {
+        if (columnModels[it.key()]->prefersReset(it.value())) {
+            resetColumns.append(it.key());
+            columnModels[it.key()]->resetTasks(filter);
+        }
+    }
 
-        columns[task.getStatus()]->addTaskCard(card);
+    // Фаза 1: убираем строки удаляемых и перемещаемых задач
+    for (const CardOperation& op : operations) {
+        if (op.kind == CardOperation::Remove && !resetColumns.contains(op.status)) {
+            columnModels[op.status]->removeTask(op.taskId);
+        } else if (op.kind == CardOperation::Move && !resetColumns.contains(op.previousStatus)) {
+            columnModels[op.previousStatus]->removeTask(op.taskId);
+        }
     }
 
-    showWarningIfUnassigned(); // Предупреждение о неназначеннных задачах
-    updateStatistics();
+    // Фаза 2: вставки по возрастанию позиций и перерисовка изменившихся строк
+    for (const CardOperation& op : operations) {
+        if (resetColumns.contains(op.status)) {
+            continue;
+        }
+        switch (op.kind) {
+        case CardOperation::Insert:
+        case CardOperation::Move:
+            columnModels[op.status]->insertTask(op.index, op.task);
+            break;
+        case CardOperation::Update:
+            columnModels[op.status]->updateTask(op.taskId);
+            break;
+        case CardOperation::Remove:
+            break;
+        }
+    }
+}
+
+TaskCard* MainWindow::createTaskCard(Task* task) {
+    TaskCard* card = new TaskCard(task, &board, this); // Создание карточки для задачи
+
+    connect(card, &TaskCard::editClicked, this, &MainWindow::onTaskEdit);
+    connect(card, &TaskCard::deleteClicked, this, &MainWindow::onTaskDelete);
+    connect(card, &TaskCard::statusChangeClicked, this, &MainWindow::onTaskStatusChange);
+    return card;
 }
 
 // Проверка соответствия задачи поисковому запросу
-bool MainWindow::matchesSearch(Task* task) {
+bool MainWindow::matchesSearch(const Task& task) const {
     if (searchFilter.isEmpty()) {
         return true;
     }
 
-    return task->getTitle().toLower().contains(searchFilter.toLower());     // Поиск по названию задачи (без учета регистра)
+    return task.getTitle().contains(searchFilter, Qt::CaseInsensitive);     // Поиск по названию задачи (без учета регистра)
 }
 
 void MainWindow::onSearchTextChanged(const QString& text) {
@@ -192,12 +322,12 @@ void MainWindow::onSearchTextChanged(const QString& text) {
 }
 
 void MainWindow::updateStatistics() {
-    // Подсчет задач по статусам
-    int backlog = board.getTasksByStatus(TaskStatus::Backlog).size();
-    int assigned = board.getTasksByStatus(TaskStatus::Assigned).size();
-    int inProgress = board.getTasksByStatus(TaskStatus::InProgress).size();
-    int review = board.getTasksByStatus(TaskStatus::Review).size();
-    int done = board.getTasksByStatus(TaskStatus::Done).size();
+    // Подсчет задач по статусам (O(1) по индексу доски)
+    int backlog = board.countByStatus(TaskStatus::Backlog);
+    int assigned = board.countByStatus(TaskStatus::Assigned);
+    int inProgress = board.countByStatus(TaskStatus::InProgress);
+    int review = board.countByStatus(TaskStatus::Review);
+    int done = board.countByStatus(TaskStatus::Done);
     int total = board.getTasks().size();
 
     int percentDone = total > 0 ? (done * 100 / total) : 0;
@@ -208,6 +338,7 @@ void MainWindow::updateStatistics() {
                         .arg(percentDone);
 
     statsLabel->setText(stats);
+    setWindowModified(board.hasUnsavedChanges()); // Любое изменение доски проходит через обновление статистики
 }
 
 void MainWindow::showWarningIfUnassigned() {
@@ -221,11 +352,15 @@ void MainWindow::showWarningIfUnassigned() {
 }
 
 void MainWindow::onNewBoard() {
-    QMessageBox::StandardButton reply = QMessageBox::question(
-        this, "Новая доска",
-        "Создать новую доску? Все несохраненные данные будут потеряны.",
-        QMessageBox::Yes | QMessageBox::No
-        );
+    // Спрашиваем, только если есть что терять: изменения доски с журналом уже на диске
+    QMessageBox::StandardButton reply = QMessageBox::Yes;
+    if (board.hasUnsavedChanges() && !board.isJournaling()) {
+        reply = QMessageBox::question(
+            this, "Новая доска",
+            "Создать новую доску? Все несохраненные данные будут потеряны.",
+            QMessageBox::Yes | QMessageBox::No
+            );
+    }
 
     if (reply == QMessageBox::Yes) {
         board.clear();
@@ -235,23 +370,92 @@ void MainWindow::onNewBoard() {
     }
 }
 
+// Индикатор и обработчики фонового сохранения
+void MainWindow::setupSaving() {
+    saveProgress = new QProgressBar(this);
+    saveProgress->setMaximumWidth(200);
+    saveProgress->setFormat("Сохранение: %p%");
+    saveProgress->hide();
+    statusBar()->addPermanentWidget(saveProgress); // Постоянный виджет не мешает предупреждениям строки состояния
+
+    // Сигналы приходят из рабочего потока сохранителя - через очередь событий окна
+    connect(&boardSaver, &BoardSaver::progress, this, [this](const QString&, int written, int total) {
+        saveProgress->setRange(0, total);
+        saveProgress->setValue(written);
+        saveProgress->show();
+    });
+    connect(&boardSaver, &BoardSaver::finished, this, [this](const QString& filename, bool success,
+                                                            const FileFingerprint& fingerprint) {
+        if (!boardSaver.isBusy()) {
+            saveProgress->hide();
+        }
+        board.finishCompaction(success, fingerprint); // Журнал переходит на записанный снимок
+        if (success) { // Изменения, сделанные во время записи, остаются несохраненными
+            board.markSaved(filename, savingFormat, savingChangeCount);
+            setWindowModified(board.hasUnsavedChanges());
+        }
+
+        if (automaticSave) { // Сжатие журнала не отвлекает пользователя окнами
+            automaticSave = false;
+            if (!success) {
+                statusBar()->showMessage(QString("Не удалось обновить файл %1").arg(filename), 5000);
+            }
+        } else if (success) {
+            QMessageBox::information(this, "Успех", "Доска успешно сохранена");
+        } else {
+            QMessageBox::critical(this, "Ошибка", QString("Не удалось сохранить доску в файл %1").arg(filename));
+        }
+    });
+
+    // Журнал изменений: пачка записей уходит на диск раз в интервал, разросшийся журнал
+    // сжимается в свежий снимок в фоне. Так каждое действие сохранено почти сразу и почти даром
+    journalTimer = new QTimer(this);
+    journalTimer->setInterval(JournalSyncIntervalMs);
+    connect(journalTimer, &QTimer::timeout, this, [this]() {
+        board.syncJournal();
+        if (board.journalNeedsCompaction() && !boardSaver.isBusy()) {
+            saveInBackground(board.journalFile(), true);
+        }
+    });
+    journalTimer->start();
+}
+
+// Снимок снимается сразу, запись идет в фоне: доску можно редактировать дальше,
+// изменения за время записи попадают в новый журнал файла. Результат сообщит BoardSaver::finished
+void MainWindow::saveInBackground(const QString& filename, bool automatic) {
+    // Расширение .sbb - компактный бинарный формат, .sbs - сегменты, иначе JSON
+    Board::FileFormat format = Board::FileFormat::Json;
+    if (filename.endsWith(".sbb", Qt::CaseInsensitive)) {
+        format = Board::FileFormat::Binary;
+    } else if (filename.endsWith(".sbs", Qt::CaseInsensitive)) {
+        format = Board::FileFormat::Segmented; // Переписываются только измененные сегменты
+    } else if (automatic) {
+        format = Board::formatOf(filename); // Сжатие журнала сохраняет вид JSON (компактный остается компактным)
+    }
+    automaticSave = automatic;
+    savingFormat = format;
+    BoardSnapshot snapshot = board.beginCompaction(filename, format);
+    savingChangeCount = snapshot.getChangeCount();
+    boardSaver.save(snapshot, filename, format);
+}
+
 void MainWindow::onSaveBoard() {
     QString filename = QFileDialog::getSaveFileName(
-        this, "Сохранить доску", "", "JSON Files (*.json)"
+        this, "Сохранить доску", "", "JSON Files (*.json);;Бинарный формат (*.sbb);;Сегментированный формат (*.sbs)"
         );
 
     if (!filename.isEmpty()) {
-        if (board.saveToFile(filename)) {
-            QMessageBox::information(this, "Успех", "Доска успешно сохранена");
-        } else {
-            QMessageBox::critical(this, "Ошибка", "Не удалось сохранить доску");
+        if (boardSaver.isBusy()) { // Журнал переключается на новый снимок по одному сохранению за раз
+            QMessageBox::warning(this, "Сохранение", "Дождитесь окончания текущего сохранения");
+            return;
         }
+        saveInBackground(filename, false);
     }
 }
 
 void MainWindow::onLoadBoard() {
     QString filename = QFileDialog::getOpenFileName(
-        this, "Загрузить доску", "", "JSON Files (*.json)"
+        this, "Загрузить доску", "", "Доски (*.json *.sbb *.sbs);;JSON Files (*.json);;Бинарный формат (*.sbb);;Сегментированный формат (*.sbs)"
         );
 
     if (!filename.isEmpty()) {
@@ -262,6 +466,11 @@ void MainWindow::onLoadBoard() {
 // Загрузка доски из указанного файла
 void MainWindow::loadBoard(const QString& filePath) {
     if (board.loadFromFile(filePath)) {
+        if (!board.openJournal(filePath)) { // Дальнейшие изменения дописываются в журнал файла
+            QMessageBox::warning(this, "Журнал", "Не удалось открыть журнал изменений: изменения нужно сохранять вручную");
+        } else if (board.journalNeedsCompaction() && !boardSaver.isBusy()) {
+            saveInBackground(filePath, true); // Восстановленные из журнала изменения - в свежий снимок
+        }
         searchBox->clear();
         refreshBoard();
         QMessageBox::information(this, "Успех", "Доска успешно загружена");
@@ -336,7 +545,7 @@ void MainWindow::onManageDevelopers() {
     connect(deleteBtn, &QPushButton::clicked, [this, devList, &dialog]() {
         QListWidgetItem* item = devList->currentItem(); // Получение выбранного элемента
         if (item) {
-            int devId = item->data(Qt::UserRole).toInt();  // Получение ID разработчика
+            DeveloperId devId = item->data(Qt::UserRole).toLongLong();  // Получение ID разработчика
 
             QMessageBox::StandardButton reply = QMessageBox::question(
                 this, "Удаление",
@@ -360,7 +569,7 @@ void MainWindow::onManageDevelopers() {
 }
 
 // Слот для обработки перетаскивания задачи между колонками
-void MainWindow::onTaskDropped(int taskId, TaskStatus newStatus) {
+void MainWindow::onTaskDropped(TaskId taskId, TaskStatus newStatus) {
     Task* task = board.getTask(taskId); // Получение задачи по ID
     if (task && task->getStatus() != newStatus) {
         task->setStatus(newStatus);
@@ -479,8 +688,8 @@ void MainWindow::onTaskEdit(Task* task) {
     if (task->isAssigned()) {
         for (int i = 0; i < devCombo->count(); i++) {
             // itemData(i) возвращает QVariant - универсальный тип данных Qt
-            // .toInt() преобразует QVariant в целое число (ID разработчика)
-            if (devCombo->itemData(i).toInt() == task->getAssignedDeveloperId()) {  
+            // .toLongLong() преобразует QVariant в целое число (ID разработчика)
+            if (devCombo->itemData(i).toLongLong() == task->getAssignedDeveloperId()) {  
                 devCombo->setCurrentIndex(i); // Если ID совпадает - устанавливаем этот элемент как текущий выбранный
                 break;
             }
@@ -524,7 +733,7 @@ void MainWindow::onTaskEdit(Task* task) {
         task->setTitle(titleEdit->text().trimmed());
         task->setDescription(descEdit->toPlainText().trimmed());
 
-        int devId = devCombo->currentData().toInt();   // Назначение/снятие разработчик
+        DeveloperId devId = devCombo->currentData().toLongLong();   // Назначение/снятие разработчик
         if (devId == -1) {
             task->unassign();  // Снять назначение
         } else {
@@ -590,11 +799,11 @@ void MainWindow::onShowStatistics() {
 
     QVBoxLayout* layout = new QVBoxLayout(&dialog);
 
-    int backlog = board.getTasksByStatus(TaskStatus::Backlog).size();
-    int assigned = board.getTasksByStatus(TaskStatus::Assigned).size();
-    int inProgress = board.getTasksByStatus(TaskStatus::InProgress).size();
-    int review = board.getTasksByStatus(TaskStatus::Review).size();
-    int done = board.getTasksByStatus(TaskStatus::Done).size();
+    int backlog = board.countByStatus(TaskStatus::Backlog);
+    int assigned = board.countByStatus(TaskStatus::Assigned);
+    int inProgress = board.countByStatus(TaskStatus::InProgress);
+    int review = board.countByStatus(TaskStatus::Review);
+    int done = board.countByStatus(TaskStatus::Done);
     int total = board.getTasks().size();
 
     int percentDone = total > 0 ? (done * 100 / total) : 0;
@@ -636,14 +845,20 @@ void MainWindow::onShowStatistics() {
     int todayCount = 0;  // Дедлайн сегодня
     int soonCount = 0; // Дедлайн в ближайшие 1-3 дня
 
-    // Подсчет задач по срочности дедлайнов
-    for (const Task& task : board.getTasks()) {
-        if (task.hasDeadline() && task.getStatus() != TaskStatus::Done) {
-            if (task.isOverdue()) {
+    // Подсчет задач по срочности дедлайнов: обход индексов незавершенных статусов без копий,
+    // текущее время берется один раз на весь подсчет
+    const QDateTime now = QDateTime::currentDateTime();
+    for (TaskStatus status : {TaskStatus::Backlog, TaskStatus::Assigned, TaskStatus::InProgress, TaskStatus::Review}) {
+        for (const Task* task : board.tasksWithStatus(status)) {
+            if (!task->hasDeadline()) {
+                continue;
+            }
+            int days = task->daysUntilDeadline(now);
+            if (task->isOverdue(now)) {
                 overdueCount++;
-            } else if (task.daysUntilDeadline() == 0) {
+            } else if (days == 0) {
                 todayCount++;
-            } else if (task.daysUntilDeadline() <= 3) {
+            } else if (days <= 3) {
                 soonCount++;
             }
         }
@@ -691,7 +906,7 @@ void MainWindow::onShowStatistics() {
     int maxTasks = 0;
     QString topDev = "—";
     for (const Developer& dev : board.getDevelopers()) {
-        int taskCount = board.getTasksByDeveloper(dev.getId()).size();
+        int taskCount = board.countByDeveloper(dev.getId());
         if (taskCount > maxTasks) {
             maxTasks = taskCount;
             topDev = dev.getName();
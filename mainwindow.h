@@ -6,7 +6,15 @@
 #include <QLineEdit>    // Виджет для однострочного текстового ввода (поиск)
 #include <QLabel>       // Виджет для отображения текста (статистика)
 #include "models/board.h"
+#include "models/boardreconciler.h"
+#include "models/boardsaver.h"
 #include "widgets/columnwidget.h"
+#include "widgets/columnmodel.h"
+#include "widgets/taskcardpool.h"
+
+class TaskCardDelegate;
+class QProgressBar;
+class QTimer;
 
 QT_BEGIN_NAMESPACE // Начало пространства имен Qt (нужно для Ui класса)
 namespace Ui {
@@ -41,11 +49,18 @@ private slots:
     void onTaskStatusChange(Task* task);
 
     void onSearchTextChanged(const QString& text);
-    void onTaskDropped(int taskId, TaskStatus newStatus);
+    void onTaskDropped(TaskId taskId, TaskStatus newStatus);
 
 private:
     Ui::MainWindow *ui; // Указатель на сгенерированный UI (форму)
     Board board;  // Модель данных доски (хранит задачи, разработчиков, логику)
+    BoardSaver boardSaver; // Запись снимков доски в рабочем потоке
+    QProgressBar* saveProgress; // Ход фонового сохранения в строке состояния
+    bool automaticSave = false; // Текущее фоновое сохранение - сжатие журнала, а не команда пользователя
+    Board::FileFormat savingFormat = Board::FileFormat::Json; // Формат и состояние доски в текущем сохранении
+    quint64 savingChangeCount = 0;
+    static constexpr int JournalSyncIntervalMs = 1000; // Период сброса журнала изменений на диск
+    QTimer* journalTimer;
 
     // Контейнер для связи статусов задач с виджетами столбцов
     // Ключ: TaskStatus (например, TODO, IN_PROGRESS, DONE)
@@ -56,13 +71,30 @@ private:
 
     QString searchFilter;
 
+    // Показанные карточки по ID задачи и сверка доски с ними
+    QHash<TaskId, TaskCard*> cards;
+    BoardReconciler reconciler;
+    TaskCardPool cardPool; // Снятые карточки переиспользуются при вставке вместо создания новых
+
+    // Виртуализированный режим для больших досок: модель на колонку и общий делегат
+    static constexpr int VirtualizationThreshold = 300; // Число задач, после которого карточки-виджеты не создаются
+    QMap<TaskStatus, ColumnModel*> columnModels;
+    TaskCardDelegate* cardDelegate;
+    bool virtualized = false;
+
     void setupUI(); // Настройка основного интерфейса
     void setupMenuBar();  // Создание и настройка меню (File, Edit, View и т.д.)
     void setupToolBar();  // Создание и настройка панели инструментов (кнопки быстрого доступа)
-    void refreshBoard(); // Полное обновление отображения доски (перерисовка всех столбцов и задач)
+    void setupSaving();   // Индикатор хода фонового сохранения, обработка его результата и журнал
+    void saveInBackground(const QString& filename, bool automatic); // Снимок доски в файл, журнал переходит на него
+    void refreshBoard(); // Обновление отображения доски: применяются только изменения относительно показанного
     void updateStatistics();  // Обновление статистики (отображается в statsLabel)
     void showWarningIfUnassigned();   // Проверка наличия неприсвоенных задач и вывод предупреждения
-    bool matchesSearch(Task* task);  // Проверка, соответствует ли задача текущему поисковому запросу
+    bool matchesSearch(const Task& task) const;  // Проверка, соответствует ли задача текущему поисковому запросу
+    TaskCard* createTaskCard(Task* task); // Создание карточки с подключенными сигналами
+    void reconcileCards(); // Режим виджетов: применение операций сверки к карточкам
+    void reconcileModels(); // Виртуализированный режим: те же операции - строкам моделей колонок
+    void setVirtualized(bool enabled); // Переключение колонок между карточками-виджетами и списком с делегатом
 };
 
 #endif // MAINWINDOW_H
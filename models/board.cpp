@@ -1,83 +1,233 @@
 #include "board.h"
+#include "boardbinary.h"
+#include "boardjournal.h"
+#include "boardsegments.h"
+#include "boardsnapshot.h"
+#include "jsonstream.h"
 #include <QFile> // Для работы с файлами
-#include <QJsonArray> // Для работы с JSON массивами
-#include <QJsonDocument> // Для работы с JSON документами
- 
-Board::Board() {
-}
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <limits>
 
-void Board::addDeveloper(const Developer& developer) {  // developer передается по константной ссылке для избежания копирования
-    developers.append(developer); // Добавляем копию разработчика в список
-}
+namespace {
 
-bool Board::removeDeveloper(int developerId) {
-    for (int i = 0; i < developers.size(); i++) {
-        if (developers[i].getId() == developerId) {
-            // Снимаем назначение со всех задач этого разработчика
-            for (Task& task : tasks) {
-                if (task.getAssignedDeveloperId() == developerId) {
-                    task.unassign();  // Снимаем назначение с задачи
+// Разбор корневого объекта доски. Массив задач читает readTasks (значение "tasks"
+// целиком), чтобы последовательная и параллельная загрузка делили остальной разбор
+template <typename ReadTasks>
+bool readBoardJson(JsonStreamReader& reader, QList<Developer>& developers, ReadTasks readTasks) {
+    if (!reader.enterObject()) {
+        return false; // Корнем должен быть объект
+    }
+
+    QString key;
+    while (reader.nextKey(key)) {
+        if (key == QLatin1String("developers")) {
+            developers.clear(); // При повторе ключа побеждает последнее значение
+            if (reader.enterArray()) {
+                while (reader.nextElement()) {
+                    developers.append(Developer::fromJsonStream(reader));
                 }
+            } else {
+                reader.skipValue();
             }
-            developers.removeAt(i);
-            return true;
+        } else if (key == QLatin1String("tasks")) {
+            readTasks(reader);
+        } else {
+            reader.skipValue();
         }
     }
-    return false; // Разработчик с таким ID не найден
+
+    return reader.atEnd(); // Ошибка синтаксиса или мусор после документа
 }
 
-// Получение разработчика по ID
-Developer* Board::getDeveloper(int developerId) {
-    for (Developer& dev : developers) {
-        if (dev.getId() == developerId) {
-            return &dev;
+// Байтовый диапазон одной задачи в тексте файла
+struct TaskSpan {
+    qint64 begin;
+    qint64 end;
+};
+
+struct TaskChunk {
+    QList<Task> tasks;
+    bool ok = true;
+};
+
+// Разбор диапазона задач в рабочем потоке. Каждый поток пишет только в свой TaskChunk;
+// разбор задачи не трогает общего состояния - ID резервирует доска при слиянии
+class TaskChunkDecoder : public QRunnable {
+public:
+    TaskChunkDecoder(const QByteArray& text, const QVector<TaskSpan>& spans, int first, int last, TaskChunk* chunk)
+        : text(text), spans(spans), first(first), last(last), chunk(chunk) {}
+
+    void run() override {
+        chunk->tasks.reserve(last - first);
+        for (int i = first; i < last; i++) {
+            const TaskSpan& span = spans[i];
+            JsonStreamReader reader(QByteArray::fromRawData(text.constData() + span.begin, int(span.end - span.begin)));
+            chunk->tasks.append(Task::fromJsonStream(reader));
+            if (!reader.atEnd()) {
+                chunk->ok = false;
+                return;
+            }
         }
     }
-    return nullptr; // Если не нашли - возвращаем нулевой указатель
+
+private:
+    const QByteArray& text;
+    const QVector<TaskSpan>& spans;
+    int first;
+    int last;
+    TaskChunk* chunk;
+};
+
+} // namespace
+
+Board::Board() : historyArchive(std::make_shared<HistoryArchive>()) {
 }
 
-void Board::addTask(const Task& task) {
-    tasks.append(task);
+Board::~Board() = default; // Журнал сбрасывает накопленные записи
+
+void Board::reserveId(std::atomic<qint64>& next, qint64 id) {
+    qint64 current = next.load(std::memory_order_relaxed);
+    while (id >= current && !next.compare_exchange_weak(current, id + 1, std::memory_order_relaxed)) {
+        // current обновлен compare_exchange_weak - повторяем, пока чужой поток не выдал больший ID
+    }
 }
 
-bool Board::removeTask(int taskId) {
-    for (int i = 0; i < tasks.size(); i++) {
-        if (tasks[i].getId() == taskId) {
-            tasks.removeAt(i);
-            return true;
-        }
+Developer* Board::addDeveloper(const Developer& developer) {  // developer передается по константной ссылке для избежания копирования
+    DeveloperHandle handle = developers.insert(developer); // Добавляем копию разработчика
+    Developer* stored = developers.get(handle);
+    if (stored->getId() > 0 && !developerIndex.contains(stored->getId())) {
+        reserveId(nextDeveloperId, stored->getId()); // Загруженный ID больше не выдается
+    } else {
+        stored->assignId(allocateDeveloperId()); // Новый или повторяющийся ID (дубликат в файле)
+    }
+    developerIndex.insert(stored->getId(), handle);
+    touch();
+    if (journal) {
+        journal->recordAddDeveloper(*stored);
     }
-    return false;
+    return stored;
 }
 
-Task* Board::getTask(int taskId) {
-    for (Task& task : tasks) {
-        if (task.getId() == taskId) {
-            return &task;
-        }
+bool Board::removeDeveloper(DeveloperId developerId) {
+    DeveloperHandle handle = developerIndex.value(developerId);
+    if (!developers.contains(handle)) {
+        return false; // Разработчик с таким ID не найден
+    }
+
+    // Снимаем назначение только с задач этого разработчика: O(число его задач).
+    // Множество забираем из индекса заранее, т.к. unassign() сообщает доске об изменении
+    const TaskSet assignedTasks = developerTaskIndex.take(developerId);
+    for (Task* task : assignedTasks) {
+        task->unassign();  // Снимаем назначение с задачи
+    }
+    developers.remove(handle);
+    developerIndex.remove(developerId);
+    touch();
+    if (journal) { // После снятий назначения: при воспроизведении задачи уже свободны
+        journal->recordRemoveDeveloper(developerId);
     }
-    return nullptr;  // Задача не найдена
+    return true;
 }
 
-QList<Task*> Board::getTasksByStatus(TaskStatus status) {
-    QList<Task*> result;  // Создаем список указателей на задачи
-    for (Task& task : tasks) {
-        if (task.getStatus() == status) {
-            result.append(&task); // Добавляем указатель на задачу в результат
-        }
+// Получение разработчика по ID за O(1) через индекс
+Developer* Board::getDeveloper(DeveloperId developerId) {
+    return developers.get(developerIndex.value(developerId)); // Если не нашли - нулевой указатель
+}
+
+Task* Board::addTask(const Task& task) {
+    TaskHandle handle = tasks.insert(task);
+    Task* stored = tasks.get(handle);
+    if (stored->getId() > 0 && !taskIndex.contains(stored->getId())) {
+        reserveId(nextTaskId, stored->getId());
+    } else {
+        stored->assignId(allocateTaskId()); // Дубликат получает свой ID, иначе до него не добраться
+    }
+    taskIndex.insert(stored->getId(), handle);
+
+    stored->attachToBoard(this, nextSequence++); // Задача будет сообщать доске о смене статуса
+    stored->limitHistory(historyLimit, historyArchive); // Длинная загруженная история сразу уходит в архив
+    statusIndex[statusSlot(stored->getStatus())].insert(stored->boardSequence(), stored);
+    indexAssignee(stored);
+    touchTask(stored->getId());
+    if (journal && !journal->recordAddTask(*stored)) {
+        closeJournal(); // Без этой записи журнал не восстановит доску: изменения - только ручным сохранением
     }
-    return result;  // Возвращаем список
+    return stored;
 }
 
-QList<Task*> Board::getTasksByDeveloper(int developerId) {
-    QList<Task*> result;
-    for (Task& task : tasks) {         
-        // Проверяем, назначена ли задача данному разработчику
-        if (task.getAssignedDeveloperId() == developerId) {
-            result.append(&task);
-        }
+bool Board::removeTask(TaskId taskId) {
+    TaskHandle handle = taskIndex.value(taskId);
+    Task* task = tasks.get(handle);
+    if (!task) {
+        return false;
     }
-    return result;
+    statusIndex[statusSlot(task->getStatus())].remove(task->boardSequence());
+    unindexAssignee(task, task->getAssignedDeveloperId());
+    tasks.remove(handle);
+    taskIndex.remove(taskId);
+    touchTask(taskId);
+    if (journal) {
+        journal->recordRemoveTask(taskId);
+    }
+    return true;
+}
+
+// Вызывается задачей из setStatus: переносим ее между множествами статусов
+void Board::taskStatusChanged(Task* task, TaskStatus oldStatus) {
+    statusIndex[statusSlot(oldStatus)].remove(task->boardSequence());
+    statusIndex[statusSlot(task->getStatus())].insert(task->boardSequence(), task);
+}
+
+// Вызывается задачей из assignToDeveloper/unassign
+void Board::taskAssigneeChanged(Task* task, DeveloperId oldDeveloperId) {
+    unindexAssignee(task, oldDeveloperId);
+    indexAssignee(task);
+}
+
+// Вызывается задачей из любого сеттера
+void Board::taskEdited(Task* task, TaskField field) {
+    touchTask(task->getId());
+    if (journal) {
+        journal->recordTaskEdit(*task, field);
+    }
+}
+
+void Board::indexAssignee(Task* task) {
+    if (task->isAssigned()) {
+        developerTaskIndex[task->getAssignedDeveloperId()].insert(task->boardSequence(), task);
+    }
+}
+
+void Board::unindexAssignee(Task* task, DeveloperId developerId) {
+    auto it = developerTaskIndex.find(developerId);
+    if (it == developerTaskIndex.end()) {
+        return; // Не назначена или множество уже забрано (removeDeveloper)
+    }
+    it->remove(task->boardSequence());
+    if (it->isEmpty()) {
+        developerTaskIndex.erase(it);
+    }
+}
+
+Task* Board::getTask(TaskId taskId) {
+    return tasks.get(taskIndex.value(taskId)); // nullptr, если задача не найдена
+}
+
+QList<Task*> Board::getTasksByStatus(TaskStatus status) {
+    return tasksWithStatus(status).values(); // Копия индекса: O(размер результата)
+}
+
+QList<Task*> Board::getTasksByDeveloper(DeveloperId developerId) {
+    return tasksOfDeveloper(developerId).values();
+}
+
+const TaskSet& Board::tasksOfDeveloper(DeveloperId developerId) const {
+    static const TaskSet empty; // Для разработчиков без задач
+    auto it = developerTaskIndex.constFind(developerId);
+    return it != developerTaskIndex.constEnd() ? *it : empty;
 }
 
 bool Board::hasUnassignedTasks() const {
@@ -94,74 +244,292 @@ bool Board::hasUnassignedTasks() const {
 }
 
 void Board::clear() {
+    closeJournal();
     developers.clear();
     tasks.clear();
-}
+    developerIndex.clear();
+    taskIndex.clear();
+    for (TaskSet& set : statusIndex) {
+        set.clear();
+    }
+    developerTaskIndex.clear();
+    nextTaskId = 1; // ID остаются плотными: новая доска нумеруется с начала
+    nextDeveloperId = 1;
+    historyArchive = std::make_shared<HistoryArchive>(); // Прежний удалится вместе с последней копией его задач
 
-QJsonObject Board::toJson() const {
-    QJsonObject json; // Создаем пустой JSON объект
+    // Пустой доске нечего терять; с файлом она больше не связана
+    resetChangeCount = ++changeCount;
+    savedChangeCount = changeCount;
+    segmentsFile.clear();
+    dirtySegments.clear();
+}
 
-    // Сохраняем разработчиков
-    QJsonArray devsArray;
-    for (const Developer& dev : developers) {
-        devsArray.append(dev.toJson()); // Каждый разработчик должен иметь метод toJson()
+void Board::setHistoryLimit(int limit) {
+    historyLimit = qMax(0, limit);
+    for (Task& task : tasks) {
+        task.limitHistory(historyLimit, historyArchive);
     }
-    json["developers"] = devsArray;  // Добавляем массив в JSON
+}
 
-    // Сохраняем задачи
-    QJsonArray tasksArray;
-    for (const Task& task : tasks) {
-        tasksArray.append(task.toJson());
+bool Board::saveToFile(const QString& filename, FileFormat format) {
+    // Сериализация одна на синхронное и фоновое сохранение (BoardSaver)
+    BoardSnapshot snapshot = snapshotFor(filename, format);
+    FileFingerprint fingerprint;
+    if (!snapshot.saveToFile(filename, format, BoardSnapshot::Progress(), &fingerprint)) {
+        return false;
     }
-    json["tasks"] = tasksArray;
-
-    return json;
+    markSaved(filename, format, snapshot.getChangeCount());
+    fingerprintFile = filename;
+    fileFingerprint = fingerprint;
+    return true;
 }
 
-void Board::fromJson(const QJsonObject& json) {
-    clear();
+BoardSnapshot Board::snapshotFor(const QString& filename, FileFormat format) const {
+    if (format == FileFormat::Segmented && filename == segmentsFile && QFile::exists(filename)) {
+        QList<qint64> segments = dirtySegments.keys();
+        std::sort(segments.begin(), segments.end());
+        return BoardSnapshot(*this, segments);
+    }
+    return BoardSnapshot(*this);
+}
 
-    // Загружаем разработчиков
-    QJsonArray devsArray = json["developers"].toArray();
-    for (const QJsonValue& value : devsArray) {         // Developer должен иметь статический метод fromJson
-        developers.append(Developer::fromJson(value.toObject()));
+void Board::markSaved(const QString& filename, FileFormat format, quint64 snapshotChangeCount) {
+    if (snapshotChangeCount < resetChangeCount) {
+        return; // Снимок содержимого, которое уже заменено (clear или загрузка)
     }
+    savedChangeCount = qMax(savedChangeCount, snapshotChangeCount);
 
-    // Загружаем задачи
-    QJsonArray tasksArray = json["tasks"].toArray();
-    for (const QJsonValue& value : tasksArray) {
-        tasks.append(Task::fromJson(value.toObject()));
+    if (format == FileFormat::Segmented) {
+        segmentsFile = filename; // Сегменты не из снимка в файле уже совпадают с доской
+        for (auto it = dirtySegments.begin(); it != dirtySegments.end();) {
+            if (it.value() <= snapshotChangeCount) {
+                it = dirtySegments.erase(it);
+            } else {
+                ++it; // Изменен после снимка
+            }
+        }
+    } else if (filename == segmentsFile) {
+        segmentsFile.clear(); // Файл перезаписан другим форматом
     }
 }
 
-bool Board::saveToFile(const QString& filename) const {
-    QFile file(filename); // Создаем объект файла
-    // Открываем файл для записи
-    if (!file.open(QIODevice::WriteOnly)) {
+bool Board::loadFromFile(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
         return false;
     }
-    // Создаем JSON документ из нашего объекта
-    QJsonDocument doc(toJson());
-    file.write(doc.toJson());
-    file.close();
+
+    // Бинарный файл начинается с тега самоописания CBOR, JSON - с текста
+    if (BoardBinaryFormat::isBinary(file.peek(3))) {
+        QList<Developer> loadedDevelopers;
+        QList<Task> loadedTasks;
+        if (BoardSegmentStore::isManifest(file.peek(64))) {
+            file.close();
+            if (!BoardSegmentStore::read(filename, loadedDevelopers, loadedTasks)) {
+                return false; // Доска не тронута
+            }
+            // Отпечаток - только манифеста: он переписывается при каждом сохранении
+            replaceContents(filename, FileFormat::Segmented, FileFingerprint::of(filename),
+                            loadedDevelopers, loadedTasks);
+            return true;
+        }
+        FingerprintDevice device(&file);
+        if (!BoardBinaryFormat::read(&device, loadedDevelopers, loadedTasks)) {
+            return false; // Доска не тронута
+        }
+        replaceContents(filename, FileFormat::Binary, device.fingerprint(), loadedDevelopers, loadedTasks);
+        return true;
+    }
+
+    // JSON разбирается потоково, сразу в объекты - без копии файла и QJsonDocument в памяти.
+    // Копии задач из временного списка в доску разделяют данные (неявное разделение Qt).
+    // Отпечаток файла для журнала считается по ходу чтения
+    QList<Developer> loadedDevelopers;
+    QList<Task> loadedTasks;
+    FingerprintDevice device(&file);
+    JsonStreamReader reader(&device);
+    bool parsed = readBoardJson(reader, loadedDevelopers, [&loadedTasks](JsonStreamReader& stream) {
+        loadedTasks.clear();
+        if (stream.enterArray()) {
+            while (stream.nextElement()) {
+                loadedTasks.append(Task::fromJsonStream(stream));
+            }
+        } else {
+            stream.skipValue();
+        }
+    });
+    if (!parsed) {
+        return false; // Доска не тронута
+    }
+    replaceContents(filename, FileFormat::Json, device.fingerprint(), loadedDevelopers, loadedTasks);
     return true;
 }
 
-bool Board::loadFromFile(const QString& filename) {
+Board::FileFormat Board::formatOf(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return FileFormat::Json;
+    }
+    QByteArray head = file.peek(64);
+    if (!BoardBinaryFormat::isBinary(head.left(3))) {
+        // Текст с отступами переносит строку сразу после открывающей скобки, компактный - нет
+        return head.startsWith('{') && head.size() > 1 && head[1] != '\n' && head[1] != '\r'
+            ? FileFormat::JsonCompact : FileFormat::Json;
+    }
+    return BoardSegmentStore::isManifest(head) ? FileFormat::Segmented : FileFormat::Binary;
+}
+
+bool Board::loadFromFileParallel(const QString& filename, int threadCount) {
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
         return false;
     }
+    qint64 size = file.size();
+    if (BoardBinaryFormat::isBinary(file.peek(3)) || size > std::numeric_limits<int>::max()) {
+        file.close();
+        return loadFromFile(filename); // Бинарный формат и очень большие файлы - последовательно
+    }
+
+    // Файл отображается в память: потоки читают свои диапазоны без копирования
+    QByteArray text;
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (mapped) {
+        text = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), int(size));
+    } else {
+        text = file.readAll();
+    }
 
-    QByteArray data = file.readAll();     // Читаем все содержимое файла
-    file.close(); // Закрываем файл сразу после чтения
+    // Последовательный проход: разработчики разбираются сразу, у задач только
+    // проверяется синтаксис и запоминаются границы - это в разы дешевле разбора
+    QList<Developer> loadedDevelopers;
+    QVector<TaskSpan> spans;
+    JsonStreamReader reader(text);
+    bool parsed = readBoardJson(reader, loadedDevelopers, [&spans](JsonStreamReader& stream) {
+        spans.clear();
+        if (stream.enterArray()) {
+            while (stream.nextElement()) {
+                qint64 begin = stream.offset();
+                stream.skipValue();
+                spans.append(TaskSpan{begin, stream.offset()});
+            }
+        } else {
+            stream.skipValue();
+        }
+    });
+    if (!parsed) {
+        return false; // Доска не тронута
+    }
+
+    // Несколько кусков на поток: задачи разной длины выравниваются очередью пула
+    int threads = threadCount > 0 ? threadCount : QThread::idealThreadCount();
+    int chunkCount = qBound(1, threads * 4, qMax(1, spans.size() / ParallelMinChunk));
+    QVector<TaskChunk> chunks(chunkCount);
+
+    QThreadPool pool; // Свой пул: waitForDone не ждет чужих задач глобального пула
+    pool.setMaxThreadCount(threads);
+    for (int c = 0; c < chunkCount; c++) {
+        int first = int(qint64(spans.size()) * c / chunkCount);
+        int last = int(qint64(spans.size()) * (c + 1) / chunkCount);
+        pool.start(new TaskChunkDecoder(text, spans, first, last, &chunks[c]));
+    }
+    FileFingerprint fingerprint; // Пока пул разбирает задачи
+    fingerprint.size = text.size();
+    fingerprint.checksum = Crc32::update(0, text.constData(), text.size());
+    pool.waitForDone();
+
+    // Слияние в порядке файла
+    QList<Task> loadedTasks;
+    loadedTasks.reserve(spans.size());
+    for (const TaskChunk& chunk : chunks) {
+        if (!chunk.ok) {
+            return false;
+        }
+        loadedTasks.append(chunk.tasks);
+    }
 
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    // Проверяем, что документ валиден и является объектом
-    if (doc.isNull() || !doc.isObject()) {
+    replaceContents(filename, FileFormat::Json, fingerprint, loadedDevelopers, loadedTasks);
+    return true;
+}
+
+void Board::replaceContents(const QString& filename, FileFormat format, const FileFingerprint& fingerprint,
+                            const QList<Developer>& newDevelopers, const QList<Task>& newTasks) {
+    clear();
+    for (const Developer& dev : newDevelopers) {
+        addDeveloper(dev);
+    }
+    for (const Task& task : newTasks) {
+        addTask(task);
+    }
+
+    // Загруженное совпадает с файлом; воспроизведенный журнал - уже несохраненные изменения
+    resetChangeCount = changeCount;
+    savedChangeCount = changeCount;
+    dirtySegments.clear();
+    if (format == FileFormat::Segmented) {
+        segmentsFile = filename;
+    }
+    fingerprintFile = filename;
+    fileFingerprint = fingerprint;
+    BoardJournal::replay(filename, fingerprint, *this); // Изменения, не попавшие в снимок до сбоя
+}
+
+bool Board::openJournal(const QString& filename) {
+    closeJournal();
+    // Отпечаток известен после загрузки или сохранения этого файла; иначе файл читается
+    FileFingerprint fingerprint = filename == fingerprintFile ? fileFingerprint : FileFingerprint::of(filename);
+
+    std::unique_ptr<BoardJournal> opened(new BoardJournal(filename));
+    if (!opened->start(fingerprint)) {
         return false;
     }
+    journal = std::move(opened);
+    return true;
+}
+
+void Board::closeJournal() {
+    journal.reset();
+}
+
+QString Board::journalFile() const {
+    return journal ? journal->getBoardFile() : QString();
+}
+
+bool Board::syncJournal() {
+    return journal ? journal->sync() : true;
+}
+
+bool Board::journalNeedsCompaction() const {
+    return journal && journal->needsCompaction();
+}
+
+BoardSnapshot Board::beginCompaction(const QString& filename, FileFormat format) {
+    if (journal && journal->getBoardFile() != filename) {
+        closeJournal(); // Прежний файл остается со своим журналом
+    }
+    if (!journal) {
+        journal.reset(new BoardJournal(filename));
+    }
+    if (!journal->beginCompaction()) {
+        closeJournal(); // Снимок все равно будет записан, но уже без журнала
+    }
+    return snapshotFor(filename, format); // Сразу после переключения журнала: между ними нет изменений
+}
 
-    fromJson(doc.object());
+bool Board::finishCompaction(bool snapshotWritten, const FileFingerprint& snapshot) {
+    if (!journal || !journal->isCompacting()) {
+        return false;
+    }
+    if (snapshotWritten) {
+        fingerprintFile = journal->getBoardFile();
+        fileFingerprint = snapshot;
+    }
+    if (!journal->finishCompaction(snapshotWritten, snapshot)) {
+        closeJournal();
+        return false;
+    }
     return true;
-}
\ No newline at end of file
+}
+
+bool Board::isCompacting() const {
+    return journal && journal->isCompacting();
+}
@@ -2,51 +2,183 @@
 #define BOARD_H
 
 #include <QList>  // Qt контейнер для хранения списков объектов
+#include <QHash>  // Хеш-таблица для индекса по ID
+#include <QMap>   // Упорядоченные множества задач для индексов
 #include <QString> // Qt строковый класс (Юникод, безопасный)
-#include <QJsonDocument>
 #include "task.h"
 #include "developer.h"
+#include "filefingerprint.h"
+#include "slotmap.h"
+#include <atomic>
+#include <memory>
 
-class Board {
+class BoardJournal;
+class BoardSnapshot;
+
+// Дескрипторы элементов доски: остаются проверяемыми после удаления элемента
+using TaskHandle = SlotHandle;
+using DeveloperHandle = SlotHandle;
+
+// Множество задач в порядке доски (ключ - порядковый номер задачи на доске).
+// Итерация по значениям дает Task* без выделения памяти.
+using TaskSet = QMap<quint64, Task*>;
+
+class Board : private TaskObserver {
 public:
+    // Формат файла доски: текстовый JSON, компактный бинарный CBOR (см. BoardBinaryFormat)
+    // или сегменты CBOR, из которых переписываются только измененные (см. BoardSegmentStore)
+    enum class FileFormat {
+        Json,        // С отступами (как QJsonDocument::Indented)
+        JsonCompact, // Без пробелов и переводов строк
+        Binary,
+        Segmented
+    };
+
+    // Задачи хранятся сегментами по ID: сегмент - SegmentSize соседних ID
+    static constexpr int SegmentSize = 1024;
+    static qint64 segmentOf(TaskId taskId) { return (taskId - 1) / SegmentSize; } // ID начинаются с 1
+
     Board();
+    ~Board();
+    Q_DISABLE_COPY(Board) // Задачи держат указатель на свою доску
+
+    // Выдача ID: атомарная, можно вызывать из рабочих потоков. ID уникальны в пределах доски,
+    // идут подряд и начинаются заново после clear()
+    TaskId allocateTaskId() { return nextTaskId.fetch_add(1, std::memory_order_relaxed); }
+    DeveloperId allocateDeveloperId() { return nextDeveloperId.fetch_add(1, std::memory_order_relaxed); }
 
     // Управление разработчиками
-    void addDeveloper(const Developer& developer);
-    bool removeDeveloper(int developerId);
-    Developer* getDeveloper(int developerId); // Получение разработчика по ID
-    QList<Developer>& getDevelopers() { return developers; } // Возвращает ссылку на список (позволяет модифицировать)
-    const QList<Developer>& getDevelopers() const { return developers; } // Возвращает константную ссылку (только для чтения)
-
-    // Управление задачами
-    void addTask(const Task& task);
-    bool removeTask(int taskId);
-    Task* getTask(int taskId);
-    QList<Task>& getTasks() { return tasks; }
-    const QList<Task>& getTasks() const { return tasks; }
-
-    // Получение задач по статусу
+    // Адреса элементов стабильны: указатель живет, пока элемент не удален с доски.
+    // Разработчик без ID (0) получает новый, ID загруженного разработчика резервируется;
+    // повторный ID (дубликат в файле) заменяется новым, чтобы элемент был доступен по ID
+    Developer* addDeveloper(const Developer& developer);
+    bool removeDeveloper(DeveloperId developerId);
+    Developer* getDeveloper(DeveloperId developerId); // Получение разработчика по ID
+    DeveloperHandle getDeveloperHandle(DeveloperId developerId) const { return developerIndex.value(developerId); }
+    Developer* resolveDeveloper(DeveloperHandle handle) { return developers.get(handle); } // nullptr, если удален
+    SlotMap<Developer>& getDevelopers() { return developers; } // Позволяет модифицировать поля, но не состав (иначе индекс устареет)
+    const SlotMap<Developer>& getDevelopers() const { return developers; } // Только для чтения
+
+    // Управление задачами (ID - как у addDeveloper)
+    Task* addTask(const Task& task);
+    bool removeTask(TaskId taskId);
+    Task* getTask(TaskId taskId);
+    TaskHandle getTaskHandle(TaskId taskId) const { return taskIndex.value(taskId); }
+    Task* resolveTask(TaskHandle handle) { return tasks.get(handle); } // nullptr, если задача удалена
+    SlotMap<Task>& getTasks() { return tasks; } // Состав меняется только через addTask/removeTask
+    const SlotMap<Task>& getTasks() const { return tasks; }
+
+    // Получение задач по статусу (индекс поддерживается инкрементально).
+    // getTasksByStatus копирует индекс в новый список; для обхода без выделения памяти -
+    // tasksWithStatus: ссылка на сам индекс, действительна до следующего изменения доски
     QList<Task*> getTasksByStatus(TaskStatus status);
+    const TaskSet& tasksWithStatus(TaskStatus status) const { return statusIndex[statusSlot(status)]; }
+    int countByStatus(TaskStatus status) const { return statusIndex[statusSlot(status)].size(); }
 
-    // Получение задач разработчика
-    QList<Task*> getTasksByDeveloper(int developerId);
+    // Получение задач разработчика (обратный индекс developerId -> задачи)
+    QList<Task*> getTasksByDeveloper(DeveloperId developerId); // Копия; без копии - tasksOfDeveloper
+    const TaskSet& tasksOfDeveloper(DeveloperId developerId) const;
+    int countByDeveloper(DeveloperId developerId) const { return tasksOfDeveloper(developerId).size(); }
 
     // Проверка: есть ли у задачи назначенный разработчик
     bool hasUnassignedTasks() const;
 
-    // Сохранение и загрузка
-    bool saveToFile(const QString& filename) const;
-    bool loadFromFile(const QString& filename);
+    // Сохранение и загрузка (сохранение в фоне - BoardSnapshot и BoardSaver).
+    // Файл, за которым ведется журнал, перезаписывается только через beginCompaction
+    bool saveToFile(const QString& filename, FileFormat format = FileFormat::Json);
+    bool loadFromFile(const QString& filename); // Формат определяется по первым байтам файла
+    static FileFormat formatOf(const QString& filename); // Формат существующего файла (JSON - с отступами или компактный)
+    // Загрузка JSON с разбором задач в пуле потоков (0 - по числу ядер); результат как у loadFromFile
+    bool loadFromFileParallel(const QString& filename, int threadCount = 0);
 
-    // Очистка доски
+    // Очистка доски (журнал закрывается: доска больше не связана с файлом)
     void clear();
 
+    // Окно истории задач в памяти (Task::limitHistory): старшие записи уходят в архив доски
+    // на диске и читаются при запросе всей истории и сохранении. 0 - вся история в памяти
+    static constexpr int DefaultHistoryLimit = 64;
+    void setHistoryLimit(int limit);
+    int getHistoryLimit() const { return historyLimit; }
+
+    // Несохраненные изменения. Счетчик растет при каждом изменении доски и ее задач
+    // (версия отдельной задачи - Task::getRevision). Для сегментированного файла доска
+    // помнит, какие сегменты изменены после последнего сохранения в него
+    quint64 getChangeCount() const { return changeCount; }
+    bool hasUnsavedChanges() const { return changeCount != savedChangeCount; }
+    int dirtySegmentCount() const { return dirtySegments.size(); }
+    // Снимок для сохранения в filename: в сегментированный файл, куда доска уже сохранялась
+    // или откуда загружена, - только измененные сегменты, иначе вся доска
+    BoardSnapshot snapshotFor(const QString& filename, FileFormat format) const;
+    // Снимок записан в filename: изменения до него сохранены, более поздние - нет
+    void markSaved(const QString& filename, FileFormat format, quint64 snapshotChangeCount);
+
+    // Журнал изменений (BoardJournal): после openJournal каждое изменение доски и ее задач
+    // дописывается в журнал рядом с файлом, а loadFromFile воспроизводит его поверх снимка.
+    // filename - файл, из которого доска только что загружена или в который сохранена.
+    // Если остались журналы прошлой работы, их записи переходят в новый журнал и
+    // journalNeedsCompaction() сразу true: свежий снимок пишется в фоне, как при любом сжатии
+    bool openJournal(const QString& filename);
+    void closeJournal(); // Накопленные записи сбрасываются на диск
+    bool isJournaling() const { return journal != nullptr; }
+    QString journalFile() const; // Файл доски, за которым ведется журнал
+    bool syncJournal();
+    bool journalNeedsCompaction() const;
+
+    // Сжатие журнала в свежий снимок и сохранение доски с журналом: снимок пишется в filename
+    // в фоне (BoardSaver), изменения после него идут в новый журнал. finishCompaction -
+    // после окончания записи с отпечатком записанного файла (BoardSaver::finished);
+    // false - журнал больше не ведется
+    BoardSnapshot beginCompaction(const QString& filename, FileFormat format = FileFormat::Json);
+    bool finishCompaction(bool snapshotWritten, const FileFingerprint& snapshot);
+    bool isCompacting() const;
+
 private:
-    QList<Developer> developers; // Список всех разработчиков
-    QList<Task> tasks;
+    SlotMap<Developer> developers; // Все разработчики (порядок добавления сохраняется)
+    SlotMap<Task> tasks;
+
+    // Индексы ID -> дескриптор слота, поддерживаются каждой мутацией доски
+    QHash<DeveloperId, DeveloperHandle> developerIndex;
+    QHash<TaskId, TaskHandle> taskIndex;
+
+    // Индекс статусов: для каждого TaskStatus - множество задач в порядке доски
+    static constexpr int StatusCount = 5;
+    static constexpr int ParallelMinChunk = 256; // Меньше задач на кусок - накладные расходы пула дороже разбора
+    TaskSet statusIndex[StatusCount];
+    quint64 nextSequence = 1; // Не сбрасывается в clear(): номер уникален для каждого добавления
+    std::atomic<TaskId> nextTaskId{1};
+    std::atomic<DeveloperId> nextDeveloperId{1};
+
+    // Обратный индекс назначений: только назначенные задачи, пустые множества удаляются
+    QHash<DeveloperId, TaskSet> developerTaskIndex;
+
+    std::unique_ptr<BoardJournal> journal; // nullptr - изменения не журналируются
+
+    int historyLimit = DefaultHistoryLimit;
+    std::shared_ptr<HistoryArchive> historyArchive; // Файл создается при первом вытеснении
+
+    // Состояние сохранения
+    quint64 changeCount = 0;
+    quint64 savedChangeCount = 0;
+    quint64 resetChangeCount = 0; // Последняя замена всего содержимого (clear, загрузка)
+    QString segmentsFile; // Сегментированный файл, относительно которого ведутся грязные сегменты
+    QHash<qint64, quint64> dirtySegments; // Сегмент -> changeCount его последнего изменения
+    // Версия файла, загруженная или записанная последней: журнал привязывается к ней без чтения файла
+    QString fingerprintFile;
+    FileFingerprint fileFingerprint;
+
+    static int statusSlot(TaskStatus status) { return static_cast<int>(status); }
+    static void reserveId(std::atomic<qint64>& next, qint64 id); // next = max(next, id + 1)
+    void touch() { changeCount++; }
+    void touchTask(TaskId taskId) { dirtySegments.insert(segmentOf(taskId), ++changeCount); }
+    void indexAssignee(Task* task);
+    void unindexAssignee(Task* task, DeveloperId developerId);
+    void taskStatusChanged(Task* task, TaskStatus oldStatus) override;
+    void taskAssigneeChanged(Task* task, DeveloperId oldDeveloperId) override;
+    void taskEdited(Task* task, TaskField field) override;
 
-    QJsonObject toJson() const; //Создает JSON представление объекта
-    void fromJson(const QJsonObject& json); // Восстанавливает объект из JSON
+    // Содержимое, загруженное из filename; поверх воспроизводится журнал файла
+    void replaceContents(const QString& filename, FileFormat format, const FileFingerprint& fingerprint,
+                         const QList<Developer>& newDevelopers, const QList<Task>& newTasks);
 };
 
 #endif // BOARD_H
\ No newline at end of file
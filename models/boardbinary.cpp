@@ -0,0 +1,126 @@
+#include "boardbinary.h"
+#include "cborutil.h"
+#include <QIODevice>
+
+namespace {
+
+const char* const FormatName = "scrum-board";
+
+} // namespace
+
+bool BoardBinaryFormat::isBinary(const QByteArray& head) {
+    return head.size() >= 3
+        && quint8(head[0]) == 0xD9 && quint8(head[1]) == 0xD9 && quint8(head[2]) == 0xF7;
+}
+
+bool BoardBinaryFormat::write(const BoardSnapshot& snapshot, QIODevice* device, const BoardSnapshot::Progress& progress) {
+    const QVector<Developer>& developers = snapshot.getDevelopers();
+    const QVector<Task>& tasks = snapshot.getTasks();
+
+    // Таблица действий: каждая строка хранится в файле один раз
+    QHash<QString, int> actionIds;
+    QStringList actions;
+    for (const Task& task : tasks) {
+        task.collectHistoryActions(actionIds, actions);
+    }
+
+    QCborStreamWriter writer(device);
+    writer.append(QCborKnownTags::Signature);
+    writer.startMap(5);
+
+    writer.append(QLatin1String("format"));
+    writer.append(QLatin1String(FormatName));
+    writer.append(QLatin1String("version"));
+    writer.append(Version);
+
+    writer.append(QLatin1String("actions")); // До задач: читатель разбирает историю сразу
+    writer.startArray(actions.size());
+    for (const QString& action : actions) {
+        writer.append(action);
+    }
+    writer.endArray();
+
+    writer.append(QLatin1String("developers"));
+    writer.startArray(developers.size());
+    for (const Developer& dev : developers) {
+        dev.toCbor(writer);
+    }
+    writer.endArray();
+
+    writer.append(QLatin1String("tasks"));
+    writer.startArray(tasks.size());
+    for (int i = 0; i < tasks.size(); i++) {
+        if (!tasks[i].toCbor(writer, actionIds)) {
+            return false; // История задачи не прочитана из архива: файл вышел бы неполным
+        }
+        if (progress) {
+            progress(i + 1, tasks.size());
+        }
+    }
+    writer.endArray();
+
+    writer.endMap();
+    return true;
+}
+
+bool BoardBinaryFormat::read(QIODevice* device, QList<Developer>& developers, QList<Task>& tasks) {
+    QCborStreamReader reader(device);
+
+    if (!reader.isTag() || reader.toTag() != QCborTag(QCborKnownTags::Signature)) {
+        return false;
+    }
+    reader.next();
+    if (!reader.isMap()) {
+        return false;
+    }
+
+    QStringList actions;
+    bool formatSeen = false;
+
+    reader.enterContainer();
+    while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+        QString key = Cbor::readString(reader);
+
+        if (key == QLatin1String("format")) {
+            if (Cbor::readString(reader) != QLatin1String(FormatName)) {
+                return false;
+            }
+            formatSeen = true;
+        } else if (key == QLatin1String("version")) {
+            if (Cbor::readInteger(reader) > Version) {
+                return false; // Файл из более новой версии программы
+            }
+        } else if (key == QLatin1String("actions") && reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                actions.append(Cbor::readString(reader));
+            }
+            reader.leaveContainer();
+        } else if (key == QLatin1String("developers") && reader.isArray()) {
+            if (reader.isLengthKnown()) {
+                developers.reserve(int(reader.length()));
+            }
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                developers.append(Developer::fromCbor(reader));
+            }
+            reader.leaveContainer();
+        } else if (key == QLatin1String("tasks") && reader.isArray()) {
+            if (reader.isLengthKnown()) {
+                tasks.reserve(int(reader.length()));
+            }
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                tasks.append(Task::fromCbor(reader, actions));
+            }
+            reader.leaveContainer();
+        } else {
+            reader.next(); // Неизвестный ключ новой версии
+        }
+    }
+    if (reader.lastError() == QCborError::NoError) {
+        reader.leaveContainer();
+    }
+
+    return formatSeen && reader.lastError() == QCborError::NoError;
+}
@@ -0,0 +1,33 @@
+#ifndef BOARDBINARY_H
+#define BOARDBINARY_H
+
+#include <QByteArray>
+#include <QList>
+#include "task.h"
+#include "developer.h"
+#include "boardsnapshot.h"
+
+class QIODevice;
+
+// Бинарный формат доски на основе CBOR.
+// Файл начинается с тега самоописания CBOR (0xD9D9F7), далее карта:
+//   "format": "scrum-board", "version": 1,
+//   "actions": таблица строк действий истории (в записях истории - их номера),
+//   "developers": [[id, имя, должность], ...],
+//   "tasks": [[id, название, описание, статус, разработчик, дедлайн, [история]], ...]
+// Даты хранятся целыми миллисекундами от эпохи (null - нет даты).
+class BoardBinaryFormat {
+public:
+    static constexpr int Version = 1;
+
+    // Начинаются ли данные с сигнатуры бинарного формата (достаточно первых трех байт)
+    static bool isBinary(const QByteArray& head);
+
+    // false - ошибка записи или история задачи не прочитана из архива (записанное неполно)
+    static bool write(const BoardSnapshot& snapshot, QIODevice* device,
+                      const BoardSnapshot::Progress& progress = BoardSnapshot::Progress());
+    // Разбор целиком до применения: при ошибке выходные списки не используются
+    static bool read(QIODevice* device, QList<Developer>& developers, QList<Task>& tasks);
+};
+
+#endif // BOARDBINARY_H
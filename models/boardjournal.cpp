@@ -0,0 +1,499 @@
+#include "boardjournal.h"
+#include "board.h"
+#include "cborutil.h"
+#include "filefingerprint.h"
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+#ifdef Q_OS_WIN
+#include <io.h>     // _commit
+#else
+#include <unistd.h> // fsync
+#endif
+
+namespace {
+
+// Заголовок файла журнала: сигнатура, привязка к версии файла доски и ее отпечаток.
+// SBJ1 (отпечаток по размеру и времени изменения) не читается: такой журнал мог относиться к другой версии
+const char Magic[4] = {'S', 'B', 'J', '2'};
+const char* const NextSuffix = ".next";
+constexpr int HeaderSize = 24;
+constexpr int RecordHeaderSize = 8; // Длина записи и ее CRC-32
+
+enum class Binding : quint32 {
+    Snapshot = 1, // Записи идут после версии файла доски с этим отпечатком
+    Pending = 2   // Записи идут после снимка, который еще пишется; отпечаток - версия файла до него
+};
+
+enum class Operation {
+    AddDeveloper = 1, // [op, разработчик]
+    RemoveDeveloper,  // [op, id]
+    AddTask,          // [op, [действия истории], задача]
+    RemoveTask,       // [op, id]
+    EditTask          // [op, id, поле, значение, время, действие, детали]
+};
+
+// CRC-32 записи: отличает целую запись от оборванной сбоем или затертой
+quint32 crc32(const QByteArray& data) {
+    return Crc32::update(0, data.constData(), data.size());
+}
+
+// Прежняя версия чужого файла, поверх которого пишется снимок (сохранение под другим именем):
+// читать файл ради отпечатка дорого, поэтому такой следующий журнал применяется только вслед за основным
+constexpr qint64 UnknownSize = -2;
+
+QByteArray makeHeader(Binding binding, const FileFingerprint& fingerprint) {
+    QByteArray header(HeaderSize, Qt::Uninitialized);
+    char* data = header.data();
+    std::memcpy(data, Magic, sizeof(Magic));
+    qToLittleEndian<quint32>(static_cast<quint32>(binding), data + 4);
+    qToLittleEndian<qint64>(fingerprint.size, data + 8);
+    qToLittleEndian<qint64>(fingerprint.checksum, data + 16);
+    return header;
+}
+
+bool parseHeader(const QByteArray& data, Binding& binding, FileFingerprint& fingerprint) {
+    if (data.size() < HeaderSize || std::memcmp(data.constData(), Magic, sizeof(Magic)) != 0) {
+        return false;
+    }
+    const char* header = data.constData();
+    binding = static_cast<Binding>(qFromLittleEndian<quint32>(header + 4));
+    fingerprint.size = qFromLittleEndian<qint64>(header + 8);
+    fingerprint.checksum = qFromLittleEndian<qint64>(header + 16);
+    return binding == Binding::Snapshot || binding == Binding::Pending;
+}
+
+// Буферы Qt и системы - на диск
+bool syncToDisk(QFile& file) {
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+template <typename WriteFields>
+QByteArray encodeRecord(Operation operation, int fieldCount, WriteFields writeFields) {
+    QByteArray payload;
+    {
+        QCborStreamWriter writer(&payload);
+        writer.startArray(fieldCount + 1);
+        writer.append(static_cast<int>(operation));
+        writeFields(writer);
+        writer.endArray();
+    }
+    return payload;
+}
+
+void applyTaskEdit(QCborStreamReader& reader, Board& board) {
+    Task* task = board.getTask(Cbor::readInteger(reader));
+    TaskField field = static_cast<TaskField>(Cbor::readInteger(reader, -1));
+
+    QString text;
+    qint64 number = 0;
+    QDateTime date;
+    switch (field) {
+    case TaskField::Title:
+    case TaskField::Description:
+        text = Cbor::readString(reader);
+        break;
+    case TaskField::Status:
+        number = Cbor::readInteger(reader, -1);
+        break;
+    case TaskField::Assignee:
+        number = Cbor::readInteger(reader, -1);
+        break;
+    case TaskField::Deadline:
+        date = Cbor::readTimestamp(reader);
+        break;
+    default:
+        return; // Поле из более новой версии
+    }
+
+    QDateTime timestamp = Cbor::readTimestamp(reader);
+    QString action = Cbor::readString(reader);
+    TaskHistoryEntry entry(timestamp, action, Cbor::readString(reader));
+    if (!task) {
+        return;
+    }
+
+    // Изменение проходит через сеттер (индексы доски), запись истории - из журнала
+    quint64 revision = task->getRevision();
+    switch (field) {
+    case TaskField::Title:
+        task->setTitle(text);
+        break;
+    case TaskField::Description:
+        task->setDescription(text);
+        break;
+    case TaskField::Status:
+        if (number >= 0 && number <= static_cast<int>(TaskStatus::Done)) {
+            task->setStatus(static_cast<TaskStatus>(number));
+        }
+        break;
+    case TaskField::Assignee:
+        if (number == -1) {
+            task->unassign();
+        } else {
+            task->assignToDeveloper(number);
+        }
+        break;
+    case TaskField::Deadline:
+        task->setDeadline(date);
+        break;
+    }
+    if (task->getRevision() != revision) {
+        task->replaceLastHistoryEntry(entry);
+    }
+}
+
+void applyRecord(const QByteArray& payload, Board& board) {
+    QCborStreamReader reader(payload);
+    if (!reader.isArray()) {
+        return;
+    }
+    reader.enterContainer();
+
+    switch (static_cast<Operation>(Cbor::readInteger(reader))) {
+    case Operation::AddDeveloper:
+        board.addDeveloper(Developer::fromCbor(reader));
+        break;
+    case Operation::RemoveDeveloper:
+        board.removeDeveloper(Cbor::readInteger(reader));
+        break;
+    case Operation::AddTask: {
+        QStringList actions;
+        if (reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                actions.append(Cbor::readString(reader));
+            }
+            reader.leaveContainer();
+        } else {
+            reader.next();
+        }
+        board.addTask(Task::fromCbor(reader, actions));
+        break;
+    }
+    case Operation::RemoveTask:
+        board.removeTask(Cbor::readInteger(reader));
+        break;
+    case Operation::EditTask:
+        applyTaskEdit(reader, board);
+        break;
+    default:
+        break; // Операция из более новой версии
+    }
+}
+
+// Записи после заголовка - до конца файла или до первой оборванной
+QByteArray validRecords(const QByteArray& data) {
+    qint64 offset = HeaderSize;
+    while (data.size() - offset >= RecordHeaderSize) {
+        const char* header = data.constData() + offset;
+        quint32 size = qFromLittleEndian<quint32>(header);
+        quint32 checksum = qFromLittleEndian<quint32>(header + 4);
+        if (size == 0 || size > quint64(data.size() - offset - RecordHeaderSize)) {
+            break;
+        }
+        if (crc32(QByteArray::fromRawData(header + RecordHeaderSize, int(size))) != checksum) {
+            break;
+        }
+        offset += RecordHeaderSize + size;
+    }
+    return offset > HeaderSize ? data.mid(HeaderSize, int(offset - HeaderSize)) : QByteArray();
+}
+
+QByteArray readJournal(const QString& path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// Целые записи журналов файла, относящиеся к версии current, в порядке применения.
+// Основной журнал применяется только к своей версии файла. Следующий (после прерванного
+// сжатия) - если снимок успел замениться или если применен основной: тогда снимок старый,
+// и следующий журнал продолжает основной. Следующий журнал, уже привязанный к этой версии,
+// заменяет основной: его записи идут после снимка, в который вошел основной
+QByteArray collectRecords(const QString& boardFile, const FileFingerprint& current) {
+    QString mainPath = BoardJournal::pathFor(boardFile);
+    QByteArray mainData = readJournal(mainPath);
+    QByteArray nextData = readJournal(mainPath + NextSuffix);
+
+    Binding mainBinding, nextBinding;
+    FileFingerprint mainVersion, nextVersion;
+    bool hasMain = parseHeader(mainData, mainBinding, mainVersion);
+    bool hasNext = parseHeader(nextData, nextBinding, nextVersion);
+
+    if (hasNext && nextBinding == Binding::Snapshot && nextVersion == current) {
+        return validRecords(nextData);
+    }
+    QByteArray records;
+    bool mainApplied = hasMain && mainBinding == Binding::Snapshot && mainVersion == current;
+    if (mainApplied) {
+        records = validRecords(mainData);
+    }
+    if (hasNext && nextBinding == Binding::Pending
+        && (mainApplied || (nextVersion.size != UnknownSize && nextVersion != current))) {
+        records += validRecords(nextData);
+    }
+    return records;
+}
+
+} // namespace
+
+BoardJournal::BoardJournal(const QString& boardFile) : boardFile(boardFile) {
+}
+
+BoardJournal::~BoardJournal() {
+    sync();
+}
+
+QString BoardJournal::pathFor(const QString& boardFile) {
+    return boardFile + ".journal";
+}
+
+bool BoardJournal::exists(const QString& boardFile) {
+    return QFile::exists(pathFor(boardFile)) || QFile::exists(pathFor(boardFile) + NextSuffix);
+}
+
+int BoardJournal::replay(const QString& boardFile, const FileFingerprint& current, Board& board) {
+    QByteArray records = collectRecords(boardFile, current);
+    int applied = 0;
+    for (qint64 offset = 0; offset < records.size(); applied++) {
+        quint32 size = qFromLittleEndian<quint32>(records.constData() + offset);
+        applyRecord(QByteArray::fromRawData(records.constData() + offset + RecordHeaderSize, int(size)), board);
+        offset += RecordHeaderSize + size;
+    }
+    return applied;
+}
+
+// Записи прошлых журналов собираются в файл под именем следующего журнала: привязанный
+// к этой версии, он заменяет основной при загрузке, так что сбой на любом шаге
+// не применит записи дважды и не потеряет их
+bool BoardJournal::start(const FileFingerprint& fingerprint) {
+    mainFile.close();
+    nextFile.close();
+    buffer.clear();
+    bufferedRecords = 0;
+    written = 0;
+    compacting = false;
+    boardVersion = fingerprint;
+
+    QString mainPath = pathFor(boardFile);
+    QString nextPath = mainPath + NextSuffix;
+    QByteArray records = collectRecords(boardFile, fingerprint);
+
+    QSaveFile started(nextPath);
+    if (!started.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QByteArray header = makeHeader(Binding::Snapshot, fingerprint);
+    started.write(header);
+    started.write(records);
+    if (!started.commit()) { // commit дожидается диска
+        return false;
+    }
+    QFile::remove(mainPath);
+    if (!QFile::rename(nextPath, mainPath)) {
+        return false;
+    }
+
+    mainFile.setFileName(mainPath);
+    if (!mainFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+    written = records.size();
+    recovered = !records.isEmpty();
+    return true;
+}
+
+void BoardJournal::recordAddDeveloper(const Developer& developer) {
+    append(encodeRecord(Operation::AddDeveloper, 1, [&developer](QCborStreamWriter& writer) {
+        developer.toCbor(writer);
+    }));
+}
+
+void BoardJournal::recordRemoveDeveloper(DeveloperId developerId) {
+    append(encodeRecord(Operation::RemoveDeveloper, 1, [developerId](QCborStreamWriter& writer) {
+        writer.append(developerId);
+    }));
+}
+
+bool BoardJournal::recordAddTask(const Task& task) {
+    // Своя таблица действий у каждой записи: журнал читается без общего контекста
+    QHash<QString, int> actionIds;
+    QStringList actions;
+    task.collectHistoryActions(actionIds, actions);
+
+    bool complete = true;
+    QByteArray payload = encodeRecord(Operation::AddTask, 2, [&](QCborStreamWriter& writer) {
+        writer.startArray(actions.size());
+        for (const QString& action : actions) {
+            writer.append(action);
+        }
+        writer.endArray();
+        complete = task.toCbor(writer, actionIds);
+    });
+    if (!complete) {
+        return false; // Запись с неполной историей восстановила бы другую задачу
+    }
+    append(payload);
+    return true;
+}
+
+void BoardJournal::recordRemoveTask(TaskId taskId) {
+    append(encodeRecord(Operation::RemoveTask, 1, [taskId](QCborStreamWriter& writer) {
+        writer.append(taskId);
+    }));
+}
+
+void BoardJournal::recordTaskEdit(const Task& task, TaskField field) {
+    const QList<TaskHistoryEntry>& history = task.getRecentHistory(); // Последняя запись всегда в окне
+    TaskHistoryEntry entry = history.isEmpty() ? TaskHistoryEntry() : history.last();
+
+    append(encodeRecord(Operation::EditTask, 6, [&](QCborStreamWriter& writer) {
+        writer.append(task.getId());
+        writer.append(static_cast<int>(field));
+        switch (field) {
+        case TaskField::Title:
+            writer.append(task.getTitle());
+            break;
+        case TaskField::Description:
+            writer.append(task.getDescription());
+            break;
+        case TaskField::Status:
+            writer.append(static_cast<int>(task.getStatus()));
+            break;
+        case TaskField::Assignee:
+            writer.append(task.getAssignedDeveloperId());
+            break;
+        case TaskField::Deadline:
+            Cbor::writeTimestamp(writer, task.getDeadline());
+            break;
+        }
+        Cbor::writeTimestamp(writer, entry.getTimestamp());
+        writer.append(entry.getAction());
+        writer.append(entry.getDetails());
+    }));
+}
+
+void BoardJournal::append(const QByteArray& payload) {
+    char header[RecordHeaderSize];
+    qToLittleEndian<quint32>(quint32(payload.size()), header);
+    qToLittleEndian<quint32>(crc32(payload), header + 4);
+    buffer.append(header, RecordHeaderSize);
+    buffer.append(payload);
+
+    if (++bufferedRecords >= BatchRecords) {
+        sync();
+    }
+}
+
+bool BoardJournal::sync() {
+    if (buffer.isEmpty()) {
+        return true;
+    }
+    QFile& file = active();
+    if (file.write(buffer) != buffer.size()) {
+        return false; // Записи остаются в буфере до следующей попытки
+    }
+    written += buffer.size();
+    buffer.clear();
+    bufferedRecords = 0;
+    return syncToDisk(file);
+}
+
+bool BoardJournal::beginCompaction() {
+    if (compacting || (mainFile.isOpen() && !sync())) {
+        return false; // Все изменения до снимка должны быть в основном журнале
+    }
+    if (!mainFile.isOpen()) {
+        // Журнал для другого файла (сохранение под новым именем): прежние журналы
+        // этого файла относятся к версии, которая сейчас будет перезаписана
+        QFile::remove(pathFor(boardFile));
+    }
+
+    nextFile.setFileName(pathFor(boardFile) + NextSuffix);
+    if (!nextFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    // Версия файла до снимка: своя известна с привязки журнала, файл читать не нужно
+    FileFingerprint previous = boardVersion;
+    if (!mainFile.isOpen()) {
+        previous = FileFingerprint(); // Файла нет
+        if (QFile::exists(boardFile)) {
+            previous.size = UnknownSize;
+        }
+    }
+    QByteArray header = makeHeader(Binding::Pending, previous);
+    if (nextFile.write(header) != header.size() || !syncToDisk(nextFile)) {
+        nextFile.close();
+        QFile::remove(nextFile.fileName());
+        return false;
+    }
+    compacting = true;
+    written = 0;
+    return true;
+}
+
+bool BoardJournal::finishCompaction(bool snapshotWritten, const FileFingerprint& snapshot) {
+    if (!compacting) {
+        return mainFile.isOpen();
+    }
+    sync();
+    compacting = false;
+    nextFile.close();
+
+    QString mainPath = pathFor(boardFile);
+    QString nextPath = mainPath + NextSuffix;
+
+    if (!snapshotWritten) {
+        // Снимок не записан: изменения за время записи возвращаются в основной журнал
+        if (!mainFile.isOpen()) {
+            QFile::remove(nextPath); // Журнал нового файла: продолжать нечего
+            return false;
+        }
+        bool kept = false;
+        QFile next(nextPath);
+        if (next.open(QIODevice::ReadOnly)) {
+            QByteArray records = next.readAll().mid(HeaderSize);
+            next.close();
+            kept = mainFile.write(records) == records.size() && syncToDisk(mainFile);
+            written = mainFile.size() - HeaderSize;
+        }
+        if (kept) {
+            QFile::remove(nextPath);
+        }
+        return kept;
+    }
+
+    // Снимок записан: следующий журнал привязывается к новой версии файла и становится основным.
+    // До переименования загрузка находит его по привязке и под именем .next
+    QFile next(nextPath);
+    if (!next.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    QByteArray header = makeHeader(Binding::Snapshot, snapshot);
+    bool bound = next.write(header) == header.size() && syncToDisk(next);
+    next.close();
+    mainFile.close();
+    if (!bound) {
+        return false;
+    }
+
+    QFile::remove(mainPath);
+    if (!QFile::rename(nextPath, mainPath)) {
+        return false;
+    }
+    mainFile.setFileName(mainPath);
+    if (!mainFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+    written = mainFile.size() - HeaderSize;
+    boardVersion = snapshot;
+    recovered = false;
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef BOARDJOURNAL_H
+#define BOARDJOURNAL_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include "filefingerprint.h"
+#include "task.h"
+#include "developer.h"
+
+class Board;
+
+// Журнал изменений доски: файл "<файл доски>.journal" рядом с доской.
+// Каждое изменение (добавление и удаление задач и разработчиков, правка полей задачи)
+// дописывается компактной записью CBOR. Записи копятся в памяти и уходят на диск
+// пачками с fsync, поэтому после сбоя теряется не больше одной несброшенной пачки.
+// При загрузке журнал воспроизводится поверх снимка.
+//
+// Журнал привязан к версии файла доски (FileFingerprint). Отпечатки приходят от загрузки и записи
+// снимка, которые считают их попутно: сам журнал файл доски не читает. Сжатие переписывает
+// снимок в фоне: на это время новые записи идут в "<журнал>.next", который после записи
+// снимка становится основным журналом. При сбое на любом шаге загрузка выбирает
+// журналы, подходящие к оказавшемуся на диске снимку.
+class BoardJournal {
+public:
+    static constexpr int BatchRecords = 64;                   // Записей до принудительного сброса на диск
+    static constexpr qint64 CompactionBytes = 4 * 1024 * 1024; // Размер журнала, после которого его стоит сжать
+
+    explicit BoardJournal(const QString& boardFile);
+    ~BoardJournal(); // Сбрасывает накопленные записи на диск
+    Q_DISABLE_COPY(BoardJournal)
+
+    static QString pathFor(const QString& boardFile);
+    static bool exists(const QString& boardFile); // Остались ли журналы от прошлой работы с файлом
+    // Воспроизводит журналы файла поверх только что загруженного из него содержимого доски
+    // (current - отпечаток загруженной версии). Возвращает число примененных записей;
+    // оборванная при сбое запись и все после нее пропускаются
+    static int replay(const QString& boardFile, const FileFingerprint& current, Board& board);
+
+    // Журнал для версии файла доски с этим отпечатком. Записи прошлых журналов, которые к ней
+    // относятся (их уже воспроизвела загрузка), переносятся в него; тогда needsCompaction()
+    // сразу true и свежий снимок пишется обычным сжатием
+    bool start(const FileFingerprint& fingerprint);
+    QString getBoardFile() const { return boardFile; }
+
+    void recordAddDeveloper(const Developer& developer);
+    void recordRemoveDeveloper(DeveloperId developerId);
+    bool recordAddTask(const Task& task); // false - история задачи не прочитана из архива, запись не сделана
+    void recordRemoveTask(TaskId taskId);
+    void recordTaskEdit(const Task& task, TaskField field); // Новое значение поля и его запись истории
+
+    bool sync(); // Записать накопленное и дождаться диска (fsync)
+    int pendingRecords() const { return bufferedRecords; }
+    bool needsCompaction() const { return !compacting && (recovered || written + buffer.size() >= CompactionBytes); }
+
+    // Сжатие: beginCompaction - непосредственно перед снимком доски, finishCompaction -
+    // после записи снимка в файл доски (snapshot - отпечаток записанного снимка).
+    // false от finishCompaction - журнал больше не ведется
+    bool beginCompaction();
+    bool finishCompaction(bool snapshotWritten, const FileFingerprint& snapshot);
+    bool isCompacting() const { return compacting; }
+
+private:
+    QString boardFile;
+    QFile mainFile; // Журнал к текущей версии файла доски
+    QFile nextFile; // Во время сжатия: изменения после снимка
+    QByteArray buffer; // Записи, еще не отданные файлу
+    int bufferedRecords = 0;
+    qint64 written = 0; // Байт записей в активном файле
+    FileFingerprint boardVersion; // Версия файла доски, к которой привязан основной журнал
+    bool recovered = false; // В основном журнале записи прошлой работы: снимок нужен сразу
+    bool compacting = false;
+
+    QFile& active() { return compacting ? nextFile : mainFile; }
+    void append(const QByteArray& payload);
+};
+
+#endif // BOARDJOURNAL_H
@@ -0,0 +1,87 @@
+#include "boardreconciler.h"
+
+namespace {
+
+const TaskStatus columnOrder[] = {
+    TaskStatus::Backlog,
+    TaskStatus::Assigned,
+    TaskStatus::InProgress,
+    TaskStatus::Review,
+    TaskStatus::Done
+};
+
+CardOperation makeOperation(CardOperation::Kind kind, TaskId taskId, Task* task,
+                            TaskStatus status, TaskStatus previousStatus, int index) {
+    CardOperation op;
+    op.kind = kind;
+    op.taskId = taskId;
+    op.task = task;
+    op.status = status;
+    op.previousStatus = previousStatus;
+    op.index = index;
+    return op;
+}
+
+} // namespace
+
+QList<CardOperation> BoardReconciler::reconcile(Board& board, const Filter& filter) {
+    currentPass++;
+    QList<CardOperation> removals;
+    QList<CardOperation> placements;
+
+    const QDateTime now = QDateTime::currentDateTime(); // Дни до дедлайна - от одного момента для всех задач
+
+    // Проход по колонкам в порядке доски: индекс вставки = число видимых задач перед ней
+    for (TaskStatus status : columnOrder) {
+        int index = 0;
+        for (Task* task : board.tasksWithStatus(status)) {
+            if (!filter(*task)) {
+                continue; // Отфильтрованные карточки уберет проход удаления
+            }
+
+            TaskId taskId = task->getId();
+            int days = task->hasDeadline() ? task->daysUntilDeadline(now) : 999;
+            auto it = shown.find(taskId);
+
+            if (it != shown.end() && it->sequence != task->boardSequence()) {
+                // Та же ID, но задача добавлена заново (доска перезагружена) - пересоздаем карточку
+                removals.append(makeOperation(CardOperation::Remove, taskId, nullptr, it->status, it->status, -1));
+                shown.erase(it);
+                it = shown.end();
+            }
+
+            if (it == shown.end()) {
+                placements.append(makeOperation(CardOperation::Insert, taskId, task, status, status, index));
+                shown.insert(taskId, ShownCard{task->boardSequence(), status, task->getRevision(), days, currentPass});
+            } else {
+                if (it->status != status) {
+                    placements.append(makeOperation(CardOperation::Move, taskId, task, status, it->status, index));
+                } else if (it->revision != task->getRevision() || it->daysUntilDeadline != days) {
+                    placements.append(makeOperation(CardOperation::Update, taskId, task, status, status, index));
+                }
+                it->status = status;
+                it->revision = task->getRevision();
+                it->daysUntilDeadline = days;
+                it->pass = currentPass;
+            }
+            index++;
+        }
+    }
+
+    // Все, что не встретилось в этом проходе, удалено с доски или скрыто фильтром
+    for (auto it = shown.begin(); it != shown.end();) {
+        if (it->pass != currentPass) {
+            removals.append(makeOperation(CardOperation::Remove, it.key(), nullptr, it->status, it->status, -1));
+            it = shown.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    removals.append(placements);
+    return removals;
+}
+
+void BoardReconciler::reset() {
+    shown.clear();
+}
@@ -0,0 +1,50 @@
+#ifndef BOARDRECONCILER_H
+#define BOARDRECONCILER_H
+
+#include <QHash>
+#include <QList>
+#include <functional>
+#include "board.h"
+
+// Операция над карточкой, полученная сверкой модели с уже показанными карточками
+struct CardOperation {
+    enum Kind {
+        Remove, // Задача удалена или отфильтрована - карточку убрать
+        Insert, // Новая видимая задача - создать карточку
+        Move,   // Задача сменила колонку - перенести карточку (и обновить)
+        Update  // Изменились поля задачи - обновить карточку на месте
+    };
+
+    Kind kind;
+    TaskId taskId;
+    Task* task;                // nullptr для Remove
+    TaskStatus status;         // Колонка назначения (для Remove - текущая колонка карточки)
+    TaskStatus previousStatus; // Колонка, из которой уходит карточка (для Move)
+    int index;                 // Позиция в колонке назначения (для Insert и Move)
+};
+
+// Сверяет доску с тем, что уже показано, и возвращает только необходимые операции.
+// Порядок применения: сначала снять с колонок все Remove и Move, затем выполнить
+// Insert/Move/Update в порядке списка - позиции вставки идут по возрастанию.
+class BoardReconciler {
+public:
+    using Filter = std::function<bool(const Task&)>;
+
+    QList<CardOperation> reconcile(Board& board, const Filter& filter);
+    void reset(); // Забыть показанные карточки (колонки очищены извне)
+    int shownCount() const { return shown.size(); }
+
+private:
+    struct ShownCard {
+        quint64 sequence;      // Порядковый номер задачи на доске: уникален для каждого добавления
+        TaskStatus status;
+        quint64 revision;
+        int daysUntilDeadline; // Срочность меняется со временем без изменения задачи
+        quint64 pass;          // Номер сверки, в которой карточка была учтена
+    };
+
+    QHash<TaskId, ShownCard> shown;
+    quint64 currentPass = 0;
+};
+
+#endif // BOARDRECONCILER_H
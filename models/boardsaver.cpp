@@ -0,0 +1,48 @@
+#include "boardsaver.h"
+#include <QRunnable>
+
+// Задача пула: пишет снимок и сообщает о ходе записи через сигналы сохранителя
+class BoardSaveJob : public QRunnable {
+public:
+    BoardSaveJob(BoardSaver* saver, const BoardSnapshot& snapshot, const QString& filename, Board::FileFormat format)
+        : saver(saver), snapshot(snapshot), filename(filename), format(format) {}
+
+    void run() override {
+        int lastPercent = -1;
+        FileFingerprint fingerprint; // Считается по ходу записи: потоку GUI не нужно перечитывать файл
+        bool success = snapshot.saveToFile(filename, format, [this, &lastPercent](int written, int total) {
+            int percent = written * 100LL / total;
+            if (percent != lastPercent) { // Очередь GUI не засыпается сигналом на каждую задачу
+                lastPercent = percent;
+                emit saver->progress(filename, written, total);
+            }
+        }, &fingerprint);
+
+        saver->pending.fetch_sub(1); // До сигнала: в обработчике isBusy() уже учитывает завершение
+        emit saver->finished(filename, success, fingerprint);
+    }
+
+private:
+    BoardSaver* saver;
+    BoardSnapshot snapshot;
+    QString filename;
+    Board::FileFormat format;
+};
+
+BoardSaver::BoardSaver(QObject* parent) : QObject(parent) {
+    qRegisterMetaType<FileFingerprint>(); // Аргумент сигнала через очередь в поток GUI
+    pool.setMaxThreadCount(1);
+}
+
+BoardSaver::~BoardSaver() {
+    waitForFinished();
+}
+
+void BoardSaver::save(const BoardSnapshot& snapshot, const QString& filename, Board::FileFormat format) {
+    pending.fetch_add(1);
+    pool.start(new BoardSaveJob(this, snapshot, filename, format)); // Пул удалит задачу после run()
+}
+
+void BoardSaver::waitForFinished() {
+    pool.waitForDone();
+}
@@ -0,0 +1,35 @@
+#ifndef BOARDSAVER_H
+#define BOARDSAVER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include "boardsnapshot.h"
+
+// Фоновое сохранение доски: снимок сериализуется и пишется в рабочем потоке,
+// доску тем временем можно продолжать редактировать.
+// Сохранения выполняются по очереди в порядке вызова save().
+// Сигналы испускаются из рабочего потока: получатели в потоке GUI получают их через очередь.
+class BoardSaver : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BoardSaver(QObject* parent = nullptr);
+    ~BoardSaver() override; // Дожидается записи начатых сохранений
+
+    void save(const BoardSnapshot& snapshot, const QString& filename, Board::FileFormat format);
+    bool isBusy() const { return pending.load() > 0; }
+    void waitForFinished();
+
+signals:
+    void progress(const QString& filename, int written, int total); // Не чаще одного раза на процент
+    void finished(const QString& filename, bool success, const FileFingerprint& fingerprint); // Отпечаток записанного файла
+
+private:
+    friend class BoardSaveJob;
+
+    QThreadPool pool; // Один поток: два сохранения одного файла не пересекаются
+    std::atomic<int> pending{0};
+};
+
+#endif // BOARDSAVER_H
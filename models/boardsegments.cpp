@@ -0,0 +1,312 @@
+#include "boardsegments.h"
+#include "cborutil.h"
+#include <QDir>
+#include <QMap>
+#include <QSaveFile>
+#include <QSet>
+
+namespace {
+
+const char* const ManifestFormat = "scrum-board-segments";
+const char* const SegmentFormat = "scrum-board-segment";
+
+struct SegmentEntry {
+    QString file; // Имя в каталоге сегментов
+    int taskCount = 0;
+};
+
+struct Manifest {
+    qint64 generation = 0; // Растет с каждым сохранением: имена новых файлов не совпадают с живыми
+    QList<Developer> developers;
+    QMap<qint64, SegmentEntry> segments;
+};
+
+// Начало CBOR-файла: тег самоописания и карта, открытые в reader
+bool enterDocument(QCborStreamReader& reader) {
+    if (!reader.isTag() || reader.toTag() != QCborTag(QCborKnownTags::Signature)) {
+        return false;
+    }
+    reader.next();
+    if (!reader.isMap()) {
+        return false;
+    }
+    reader.enterContainer();
+    return true;
+}
+
+bool readManifest(const QString& filename, Manifest& manifest) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QCborStreamReader reader(&file);
+    if (!enterDocument(reader)) {
+        return false;
+    }
+
+    bool formatSeen = false;
+    while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+        QString key = Cbor::readString(reader);
+
+        if (key == QLatin1String("format")) {
+            if (Cbor::readString(reader) != QLatin1String(ManifestFormat)) {
+                return false;
+            }
+            formatSeen = true;
+        } else if (key == QLatin1String("version")) {
+            if (Cbor::readInteger(reader) > BoardSegmentStore::Version) {
+                return false; // Файл из более новой версии программы
+            }
+        } else if (key == QLatin1String("generation")) {
+            manifest.generation = Cbor::readInteger(reader);
+        } else if (key == QLatin1String("developers") && reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                manifest.developers.append(Developer::fromCbor(reader));
+            }
+            reader.leaveContainer();
+        } else if (key == QLatin1String("segments") && reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                if (!reader.isArray()) {
+                    reader.next();
+                    continue;
+                }
+                reader.enterContainer();
+                qint64 segment = Cbor::readInteger(reader);
+                SegmentEntry entry;
+                entry.file = Cbor::readString(reader);
+                entry.taskCount = int(Cbor::readInteger(reader));
+                Cbor::leave(reader);
+                manifest.segments.insert(segment, entry);
+            }
+            reader.leaveContainer();
+        } else {
+            reader.next(); // Неизвестный ключ новой версии
+        }
+    }
+    if (reader.lastError() == QCborError::NoError) {
+        reader.leaveContainer();
+    }
+    return formatSeen && reader.lastError() == QCborError::NoError;
+}
+
+bool writeManifest(const QString& filename, const Manifest& manifest) {
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QCborStreamWriter writer(&file);
+    writer.append(QCborKnownTags::Signature);
+    writer.startMap(5);
+    writer.append(QLatin1String("format")); // Первым: по нему формат узнается без разбора файла
+    writer.append(QLatin1String(ManifestFormat));
+    writer.append(QLatin1String("version"));
+    writer.append(BoardSegmentStore::Version);
+    writer.append(QLatin1String("generation"));
+    writer.append(manifest.generation);
+
+    writer.append(QLatin1String("developers"));
+    writer.startArray(manifest.developers.size());
+    for (const Developer& dev : manifest.developers) {
+        dev.toCbor(writer);
+    }
+    writer.endArray();
+
+    writer.append(QLatin1String("segments"));
+    writer.startArray(manifest.segments.size());
+    for (auto it = manifest.segments.constBegin(); it != manifest.segments.constEnd(); ++it) {
+        writer.startArray(3);
+        writer.append(it.key());
+        writer.append(it->file);
+        writer.append(it->taskCount);
+        writer.endArray();
+    }
+    writer.endArray();
+
+    writer.endMap();
+    return file.commit();
+}
+
+bool writeSegment(const QString& path, const QVector<const Task*>& tasks) {
+    // Таблица действий истории - своя у каждого сегмента
+    QHash<QString, int> actionIds;
+    QStringList actions;
+    for (const Task* task : tasks) {
+        task->collectHistoryActions(actionIds, actions);
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QCborStreamWriter writer(&file);
+    writer.append(QCborKnownTags::Signature);
+    writer.startMap(3);
+    writer.append(QLatin1String("format"));
+    writer.append(QLatin1String(SegmentFormat));
+
+    writer.append(QLatin1String("actions"));
+    writer.startArray(actions.size());
+    for (const QString& action : actions) {
+        writer.append(action);
+    }
+    writer.endArray();
+
+    writer.append(QLatin1String("tasks"));
+    writer.startArray(tasks.size());
+    for (const Task* task : tasks) {
+        if (!task->toCbor(writer, actionIds)) {
+            return false; // История не прочитана из архива: неполный сегмент не подменяет прежний
+        }
+    }
+    writer.endArray();
+
+    writer.endMap();
+    return file.commit();
+}
+
+bool readSegment(const QString& path, int expectedCount, QList<Task>& tasks) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QCborStreamReader reader(&file);
+    if (!enterDocument(reader)) {
+        return false;
+    }
+
+    QStringList actions;
+    bool formatSeen = false;
+    int count = 0;
+    while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+        QString key = Cbor::readString(reader);
+
+        if (key == QLatin1String("format")) {
+            if (Cbor::readString(reader) != QLatin1String(SegmentFormat)) {
+                return false;
+            }
+            formatSeen = true;
+        } else if (key == QLatin1String("actions") && reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                actions.append(Cbor::readString(reader));
+            }
+            reader.leaveContainer();
+        } else if (key == QLatin1String("tasks") && reader.isArray()) {
+            reader.enterContainer();
+            while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+                tasks.append(Task::fromCbor(reader, actions));
+                count++;
+            }
+            reader.leaveContainer();
+        } else {
+            reader.next();
+        }
+    }
+    if (reader.lastError() == QCborError::NoError) {
+        reader.leaveContainer();
+    }
+    // Число задач сверяется с манифестом: подмененный или обрезанный сегмент не принимается
+    return formatSeen && reader.lastError() == QCborError::NoError && count == expectedCount;
+}
+
+} // namespace
+
+QString BoardSegmentStore::directoryFor(const QString& filename) {
+    return filename + ".segments";
+}
+
+bool BoardSegmentStore::isManifest(const QByteArray& head) {
+    QCborStreamReader reader(head);
+    if (!enterDocument(reader)) {
+        return false;
+    }
+    return Cbor::readString(reader) == QLatin1String("format")
+        && Cbor::readString(reader) == QLatin1String(ManifestFormat);
+}
+
+bool BoardSegmentStore::write(const QString& filename, const BoardSnapshot& snapshot,
+                              const BoardSnapshot::Progress& progress) {
+    QString directory = directoryFor(filename);
+    if (!QDir().mkpath(directory)) {
+        return false;
+    }
+
+    Manifest manifest;
+    if (QFile::exists(filename) && !readManifest(filename, manifest) && snapshot.isPartial()) {
+        return false; // Частичный снимок дополняет только целый манифест
+    }
+    if (!snapshot.isPartial()) {
+        manifest.segments.clear(); // Поколение сохраняется: имена файлов не повторяются
+    }
+    manifest.generation++;
+    manifest.developers.clear();
+    for (const Developer& dev : snapshot.getDevelopers()) {
+        manifest.developers.append(dev);
+    }
+
+    // Задачи снимка по сегментам. Сегменты частичного снимка без задач уходят из манифеста
+    QMap<qint64, QVector<const Task*>> groups;
+    for (qint64 segment : snapshot.getSegments()) {
+        groups[segment];
+    }
+    for (const Task& task : snapshot.getTasks()) {
+        groups[Board::segmentOf(task.getId())].append(&task);
+    }
+
+    int written = 0;
+    int total = snapshot.getTasks().size();
+    for (auto it = groups.constBegin(); it != groups.constEnd(); ++it) {
+        if (it->isEmpty()) {
+            manifest.segments.remove(it.key());
+            continue;
+        }
+        SegmentEntry entry;
+        entry.file = QString("%1-%2.seg").arg(it.key()).arg(manifest.generation);
+        entry.taskCount = it->size();
+        if (!writeSegment(directory + "/" + entry.file, *it)) {
+            return false; // Манифест не тронут: доска на диске - прежняя
+        }
+        manifest.segments.insert(it.key(), entry);
+
+        written += it->size();
+        if (progress) {
+            progress(written, total);
+        }
+    }
+
+    if (!writeManifest(filename, manifest)) {
+        return false;
+    }
+
+    // Файлы, на которые манифест больше не ссылается: замененные и от прерванных сохранений
+    QSet<QString> referenced;
+    for (const SegmentEntry& entry : manifest.segments) {
+        referenced.insert(entry.file);
+    }
+    QDir segmentsDir(directory);
+    for (const QString& name : segmentsDir.entryList(QStringList() << "*.seg", QDir::Files)) {
+        if (!referenced.contains(name)) {
+            segmentsDir.remove(name);
+        }
+    }
+    return true;
+}
+
+bool BoardSegmentStore::read(const QString& filename, QList<Developer>& developers, QList<Task>& tasks) {
+    Manifest manifest;
+    if (!readManifest(filename, manifest)) {
+        return false;
+    }
+
+    QString directory = directoryFor(filename);
+    developers = manifest.developers;
+    for (const SegmentEntry& entry : manifest.segments) {
+        if (!readSegment(directory + "/" + entry.file, entry.taskCount, tasks)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef BOARDSEGMENTS_H
+#define BOARDSEGMENTS_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include "boardsnapshot.h"
+
+// Сегментированный формат доски: файл-манифест и каталог "<манифест>.segments" рядом с ним.
+// Задачи разбиты на сегменты по ID (Board::segmentOf), каждый сегмент - отдельный файл CBOR
+// "<сегмент>-<поколение>.seg" в том же формате, что и задачи BoardBinaryFormat.
+// Манифест (CBOR с тегом самоописания): "format": "scrum-board-segments", "version",
+// "generation", "developers" и "segments": [[сегмент, имя файла, число задач], ...].
+//
+// Сохранение частичного снимка пишет только его сегменты под новым поколением, затем
+// атомарно подменяет манифест и лишь после этого удаляет ставшие ненужными файлы:
+// сбой на любом шаге оставляет на диске прежнюю или новую версию доски целиком.
+class BoardSegmentStore {
+public:
+    static constexpr int Version = 1;
+
+    static QString directoryFor(const QString& filename);
+    // Начинаются ли данные с манифеста (достаточно первых 64 байт)
+    static bool isManifest(const QByteArray& head);
+
+    static bool write(const QString& filename, const BoardSnapshot& snapshot,
+                      const BoardSnapshot::Progress& progress = BoardSnapshot::Progress());
+    // Разбор целиком до применения: при ошибке выходные списки не используются
+    static bool read(const QString& filename, QList<Developer>& developers, QList<Task>& tasks);
+};
+
+#endif // BOARDSEGMENTS_H
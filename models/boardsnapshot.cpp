@@ -0,0 +1,120 @@
+#include "boardsnapshot.h"
+#include "boardbinary.h"
+#include "boardsegments.h"
+#include "jsonstream.h"
+#include <QSaveFile> // Атомарная запись файла
+#include <QSet>
+
+BoardSnapshot::BoardSnapshot(const Board& board) : changeCount(board.getChangeCount()) {
+    developers.reserve(board.getDevelopers().size());
+    for (const Developer& dev : board.getDevelopers()) {
+        developers.append(dev);
+    }
+
+    tasks.reserve(board.getTasks().size());
+    for (const Task& task : board.getTasks()) {
+        tasks.append(task); // Копия без связи с доской, данные разделяются
+    }
+}
+
+BoardSnapshot::BoardSnapshot(const Board& board, const QList<qint64>& segments)
+    : segments(segments), partial(true), changeCount(board.getChangeCount()) {
+    developers.reserve(board.getDevelopers().size());
+    for (const Developer& dev : board.getDevelopers()) {
+        developers.append(dev);
+    }
+
+    const SlotMap<Task>& boardTasks = board.getTasks();
+    if (qint64(segments.size()) * Board::SegmentSize < boardTasks.size()) {
+        // Мало сегментов: перебираем их ID по индексу, не трогая остальные задачи
+        for (qint64 segment : segments) {
+            TaskId first = segment * Board::SegmentSize + 1;
+            for (TaskId id = first; id < first + Board::SegmentSize; id++) {
+                if (const Task* task = boardTasks.get(board.getTaskHandle(id))) {
+                    tasks.append(*task);
+                }
+            }
+        }
+    } else {
+        QSet<qint64> wanted(segments.begin(), segments.end());
+        for (const Task& task : boardTasks) {
+            if (wanted.contains(Board::segmentOf(task.getId()))) {
+                tasks.append(task);
+            }
+        }
+    }
+}
+
+bool BoardSnapshot::writeJsonStream(JsonStreamWriter& writer, const Progress& progress) const {
+    writer.startObject();
+
+    // Сохраняем разработчиков
+    writer.writeKey("developers");
+    writer.startArray();
+    for (const Developer& dev : developers) {
+        dev.toJsonStream(writer);
+    }
+    writer.endArray();
+
+    // Сохраняем задачи
+    writer.writeKey("tasks");
+    writer.startArray();
+    for (int i = 0; i < tasks.size(); i++) {
+        if (!tasks[i].toJsonStream(writer)) {
+            return false; // История задачи не прочитана из архива: файл вышел бы неполным
+        }
+        if (progress) {
+            progress(i + 1, tasks.size());
+        }
+    }
+    writer.endArray();
+
+    writer.endObject();
+    return true;
+}
+
+bool BoardSnapshot::saveToFile(const QString& filename, Board::FileFormat format, const Progress& progress,
+                               FileFingerprint* fingerprint) const {
+    if (format == Board::FileFormat::Segmented) {
+        if (!BoardSegmentStore::write(filename, *this, progress)) { // Манифест и файлы сегментов
+            return false;
+        }
+        if (fingerprint) {
+            *fingerprint = FileFingerprint::of(filename); // Манифест невелик
+        }
+        return true;
+    }
+    if (partial) {
+        return false; // Остальные форматы - только целиком
+    }
+
+    // QSaveFile пишет во временный файл и подменяет исходный только при успехе:
+    // прерванное сохранение не портит предыдущую версию доски
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    FingerprintDevice device(&file);
+    bool written;
+    if (format == Board::FileFormat::Binary) {
+        written = BoardBinaryFormat::write(*this, &device, progress);
+    } else {
+        // JSON пишется потоково, без QJsonDocument: текст уходит в файл кусками
+        JsonStreamWriter writer(&device, format == Board::FileFormat::JsonCompact ? QJsonDocument::Compact
+                                                                                : QJsonDocument::Indented);
+        written = writeJsonStream(writer, progress) && writer.flush();
+    }
+
+    if (!written) {
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        return false;
+    }
+    if (fingerprint) {
+        *fingerprint = device.fingerprint();
+    }
+    return true;
+}
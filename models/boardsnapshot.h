@@ -0,0 +1,47 @@
+#ifndef BOARDSNAPSHOT_H
+#define BOARDSNAPSHOT_H
+
+#include <QVector>
+#include <QString>
+#include <functional>
+#include "board.h"
+
+class JsonStreamWriter;
+
+// Неизменяемый снимок содержимого доски для сохранения.
+// Копии задач и разработчиков разделяют строки, даты и историю с доской (неявное
+// разделение Qt), поэтому снимок снимается быстро, а правка задачи после снимка
+// отделяет только ее данные. Снимок не связан с доской и может писаться в другом потоке.
+class BoardSnapshot {
+public:
+    using Progress = std::function<void(int written, int total)>; // Записано задач из общего числа
+
+    BoardSnapshot() = default;
+    explicit BoardSnapshot(const Board& board); // Снимать в потоке, который владеет доской
+    // Частичный снимок для сегментированного формата: все разработчики и только задачи
+    // из перечисленных сегментов (Board::segmentOf); сегменты без задач будут удалены из файла
+    BoardSnapshot(const Board& board, const QList<qint64>& segments);
+
+    const QVector<Developer>& getDevelopers() const { return developers; }
+    const QVector<Task>& getTasks() const { return tasks; }
+    bool isPartial() const { return partial; }
+    const QList<qint64>& getSegments() const { return segments; } // Только для частичного снимка
+    quint64 getChangeCount() const { return changeCount; } // Board::getChangeCount в момент снимка
+
+    // Запись через QSaveFile: файл подменяется только при успешном завершении.
+    // Частичный снимок записывается только в сегментированный формат.
+    // fingerprint - отпечаток записанного файла (для журнала), считается по ходу записи
+    bool saveToFile(const QString& filename, Board::FileFormat format, const Progress& progress = Progress(),
+                    FileFingerprint* fingerprint = nullptr) const;
+
+private:
+    QVector<Developer> developers;
+    QVector<Task> tasks;
+    QList<qint64> segments;
+    bool partial = false;
+    quint64 changeCount = 0;
+
+    bool writeJsonStream(JsonStreamWriter& writer, const Progress& progress) const; // JSON представление доски
+};
+
+#endif // BOARDSNAPSHOT_H
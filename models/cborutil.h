@@ -0,0 +1,64 @@
+#ifndef CBORUTIL_H
+#define CBORUTIL_H
+
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QDateTime>
+#include <QString>
+
+// Мелкие помощники для потокового чтения CBOR: строки могут приходить кусками,
+// неизвестные и лишние элементы пропускаются (совместимость с будущими версиями формата)
+namespace Cbor {
+
+inline QString readString(QCborStreamReader& reader) {
+    QString result;
+    if (!reader.isString()) {
+        reader.next(); // Неожиданный тип - пропускаем элемент целиком
+        return result;
+    }
+    auto chunk = reader.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+        result += chunk.data;
+        chunk = reader.readString();
+    }
+    return result;
+}
+
+inline qint64 readInteger(QCborStreamReader& reader, qint64 fallback = 0) {
+    if (!reader.isInteger()) {
+        reader.next();
+        return fallback;
+    }
+    qint64 value = reader.toInteger();
+    reader.next();
+    return value;
+}
+
+// Время как миллисекунды от эпохи; null - отсутствующая дата
+inline void writeTimestamp(QCborStreamWriter& writer, const QDateTime& time) {
+    if (time.isValid()) {
+        writer.append(time.toMSecsSinceEpoch());
+    } else {
+        writer.appendNull();
+    }
+}
+
+inline QDateTime readTimestamp(QCborStreamReader& reader) {
+    if (!reader.isInteger()) {
+        reader.next();
+        return QDateTime();
+    }
+    return QDateTime::fromMSecsSinceEpoch(readInteger(reader));
+}
+
+// Пропустить оставшиеся элементы контейнера и выйти из него
+inline void leave(QCborStreamReader& reader) {
+    while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+        reader.next();
+    }
+    reader.leaveContainer();
+}
+
+} // namespace Cbor
+
+#endif // CBORUTIL_H
@@ -1,16 +1,14 @@
 #include "developer.h"
-
-int Developer::nextId = 1;
+#include "cborutil.h"
+#include "jsonstream.h"
 
 Developer::Developer()
-    : id(nextId++),
-    name(""),
+    : name(""),
     position("") {
 }
 
 Developer::Developer(const QString& name, const QString& position)
-    : id(nextId++),
-    name(name),
+    : name(name),
     position(position) {
 }
 
@@ -24,14 +22,61 @@ QJsonObject Developer::toJson() const {
 
 Developer Developer::fromJson(const QJsonObject& json) {
     Developer dev; // 1. Создаём временный объект
-    dev.id = json["id"].toInt();   // 2. Извлекаем id
+    dev.id = idFromJson(json["id"]);   // 2. Извлекаем id
     dev.name = json["name"].toString();
     dev.position = json["position"].toString();    // 5. Возвращаем объект
+    return dev; // ID резервирует доска при добавлении
+}
+
+void Developer::toJsonStream(JsonStreamWriter& writer) const {
+    writer.startObject(); // Ключи по алфавиту, как их упорядочивает QJsonObject
+    writer.writeMember("id", id);
+    writer.writeMember("name", name);
+    writer.writeMember("position", position);
+    writer.endObject();
+}
 
-    // Обновляем nextId если нужно
-    if (dev.id >= nextId) {
-        nextId = dev.id + 1;
+Developer Developer::fromJsonStream(JsonStreamReader& reader) {
+    Developer dev; // Отсутствующие поля - как у fromJson для пустого объекта
+    if (!reader.enterObject()) {
+        reader.skipValue();
+        return dev;
     }
 
+    QString key;
+    while (reader.nextKey(key)) {
+        if (key == QLatin1String("id")) {
+            dev.id = reader.toInt64();
+        } else if (key == QLatin1String("name")) {
+            dev.name = reader.toString();
+        } else if (key == QLatin1String("position")) {
+            dev.position = reader.toString();
+        } else {
+            reader.skipValue();
+        }
+    }
     return dev;
-}
\ No newline at end of file
+}
+
+void Developer::toCbor(QCborStreamWriter& writer) const {
+    writer.startArray(3);
+    writer.append(id);
+    writer.append(name);
+    writer.append(position);
+    writer.endArray();
+}
+
+Developer Developer::fromCbor(QCborStreamReader& reader) {
+    Developer dev;
+    if (!reader.isArray()) {
+        reader.next();
+        return dev;
+    }
+
+    reader.enterContainer();
+    dev.id = Cbor::readInteger(reader);
+    dev.name = Cbor::readString(reader);
+    dev.position = Cbor::readString(reader);
+    Cbor::leave(reader);
+    return dev;
+}
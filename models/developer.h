@@ -3,6 +3,12 @@
 
 #include <QString>
 #include <QJsonObject>
+#include "entityid.h"
+
+class QCborStreamWriter;
+class QCborStreamReader;
+class JsonStreamReader;
+class JsonStreamWriter;
 
 class Developer {
 public:
@@ -10,9 +16,10 @@ public:
     Developer(const QString& name, const QString& position = "");
 
     // Геттеры возвращают значения приватных полей
-    int getId() const { return id; }
-    QString getName() const { return name; }
-    QString getPosition() const { return position; }
+    DeveloperId getId() const { return id; } // 0 до добавления на доску
+    void assignId(DeveloperId newId) { id = newId; } // Вызывается доской
+    const QString& getName() const { return name; }
+    const QString& getPosition() const { return position; }
 
     // Сеттеры устанавливают новые значения для полей name и position
     void setName(const QString& newName) { name = newName; }
@@ -21,10 +28,13 @@ public:
     // Сериализация
     QJsonObject toJson() const; //преобразует объект Developer в JSON-объект
     static Developer fromJson(const QJsonObject& json); //создаёт объект Developer из JSON-объекта.
+    void toJsonStream(JsonStreamWriter& writer) const; // Тот же текст, что и toJson, без QJsonObject
+    static Developer fromJsonStream(JsonStreamReader& reader); // То же при потоковом чтении, без QJsonObject
+    void toCbor(QCborStreamWriter& writer) const; // Бинарный формат: [id, имя, должность]
+    static Developer fromCbor(QCborStreamReader& reader);
 
 private:
-    static int nextId; //статическая переменная для генерации уникальных ID
-    int id;
+    DeveloperId id = 0;
     QString name;
     QString position;
 };
@@ -0,0 +1,22 @@
+#ifndef ENTITYID_H
+#define ENTITYID_H
+
+#include <QtGlobal>
+#include <QJsonValue>
+#include <cmath>
+
+// ID задач и разработчиков. Выдает их доска (Board::allocateTaskId/allocateDeveloperId),
+// 0 - объект еще не добавлен на доску и ID не получил
+using TaskId = qint64;
+using DeveloperId = qint64;
+
+// ID из JSON: только целые числа (как QJsonValue::toInt, но без ограничения 32 битами)
+inline qint64 idFromJson(const QJsonValue& value, qint64 fallback = 0) {
+    double number = value.toDouble(std::nan(""));
+    if (!(std::abs(number) <= 9007199254740992.0) || std::trunc(number) != number) { // 2^53 - точные целые double
+        return fallback;
+    }
+    return static_cast<qint64>(number);
+}
+
+#endif // ENTITYID_H
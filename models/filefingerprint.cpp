@@ -0,0 +1,106 @@
+#include "filefingerprint.h"
+#include <QFile>
+#include <QtEndian>
+#include <array>
+
+namespace {
+
+// Таблицы для обработки восьми байт за шаг: tables[k][b] - вклад байта b, за которым идут еще k байт
+using Crc32Tables = std::array<std::array<quint32, 256>, 8>;
+
+const Crc32Tables& crc32Tables() {
+    static const Crc32Tables tables = [] {
+        Crc32Tables result;
+        for (quint32 i = 0; i < 256; i++) {
+            quint32 value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+            }
+            result[0][i] = value;
+        }
+        for (int i = 0; i < 256; i++) {
+            for (int k = 1; k < 8; k++) {
+                result[k][i] = (result[k - 1][i] >> 8) ^ result[0][result[k - 1][i] & 0xFF];
+            }
+        }
+        return result;
+    }();
+    return tables;
+}
+
+} // namespace
+
+quint32 Crc32::update(quint32 crc, const char* data, qint64 size) {
+    const Crc32Tables& t = crc32Tables();
+    const uchar* bytes = reinterpret_cast<const uchar*>(data);
+
+    crc = ~crc;
+    for (; size >= 8; bytes += 8, size -= 8) {
+        quint32 low = qFromLittleEndian<quint32>(bytes) ^ crc;
+        quint32 high = qFromLittleEndian<quint32>(bytes + 4);
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24]
+            ^ t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    }
+    for (; size > 0; bytes++, size--) {
+        crc = t[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+FileFingerprint FileFingerprint::of(const QString& filename) {
+    FileFingerprint fingerprint;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fingerprint;
+    }
+    quint32 crc = 0;
+    qint64 size = 0;
+    QByteArray chunk(1 << 20, Qt::Uninitialized); // Файл читается кусками: большой файл не копируется в память целиком
+    for (qint64 read; (read = file.read(chunk.data(), chunk.size())) > 0;) {
+        crc = Crc32::update(crc, chunk.constData(), read);
+        size += read;
+    }
+    fingerprint.size = size;
+    fingerprint.checksum = crc;
+    return fingerprint;
+}
+
+FingerprintDevice::FingerprintDevice(QIODevice* target) : target(target) {
+    // Запись без своего буфера: байты сразу уходят в target (QSaveFile буферизует сам)
+    OpenMode mode = target->openMode() & ReadWrite;
+    open(mode.testFlag(WriteOnly) ? mode | Unbuffered : mode);
+}
+
+qint64 FingerprintDevice::bytesAvailable() const {
+    return QIODevice::bytesAvailable() + target->bytesAvailable();
+}
+
+FileFingerprint FingerprintDevice::fingerprint() {
+    if (openMode().testFlag(ReadOnly)) {
+        char rest[4096];
+        while (read(rest, sizeof(rest)) > 0) {
+        }
+    }
+    FileFingerprint result;
+    result.size = size;
+    result.checksum = crc;
+    return result;
+}
+
+qint64 FingerprintDevice::readData(char* data, qint64 maxSize) {
+    qint64 read = target->read(data, maxSize);
+    if (read > 0) {
+        crc = Crc32::update(crc, data, read);
+        size += read;
+    }
+    return read;
+}
+
+qint64 FingerprintDevice::writeData(const char* data, qint64 length) {
+    qint64 written = target->write(data, length);
+    if (written > 0) {
+        crc = Crc32::update(crc, data, written);
+        size += written;
+    }
+    return written;
+}
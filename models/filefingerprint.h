@@ -0,0 +1,55 @@
+#ifndef FILEFINGERPRINT_H
+#define FILEFINGERPRINT_H
+
+#include <QIODevice>
+#include <QMetaType>
+#include <QString>
+
+namespace Crc32 {
+
+// CRC-32 (IEEE), по восемь байт за шаг
+quint32 update(quint32 crc, const char* data, qint64 size);
+
+} // namespace Crc32
+
+// Версия файла: размер и контрольная сумма содержимого. Время изменения не годится:
+// на файловых системах с грубым временем перезапись того же размера (манифест сегментов)
+// была бы неотличима от прежней версии.
+// Отпечаток большого файла считается попутно, пока файл пишется или читается (FingerprintDevice),
+// а не отдельным чтением
+struct FileFingerprint {
+    qint64 size = -1; // -1 - файла нет
+    qint64 checksum = -1;
+
+    bool operator==(const FileFingerprint& other) const { return size == other.size && checksum == other.checksum; }
+    bool operator!=(const FileFingerprint& other) const { return !(*this == other); }
+
+    // Отдельное чтение файла целиком: для небольших файлов (манифест сегментов) и рабочих потоков
+    static FileFingerprint of(const QString& filename);
+};
+
+Q_DECLARE_METATYPE(FileFingerprint)
+
+// Прозрачная обертка над устройством: все прочитанные или записанные через нее байты
+// попадают в отпечаток. Открывается в том же режиме, что и target (только чтение или только запись)
+class FingerprintDevice : public QIODevice {
+public:
+    explicit FingerprintDevice(QIODevice* target);
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+    // Отпечаток прошедших байт. При чтении остаток устройства сначала дочитывается:
+    // разбор мог остановиться раньше конца файла
+    FileFingerprint fingerprint();
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 length) override;
+
+private:
+    QIODevice* target;
+    quint32 crc = 0;
+    qint64 size = 0;
+};
+
+#endif // FILEFINGERPRINT_H
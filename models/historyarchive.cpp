@@ -0,0 +1,94 @@
+#include "historyarchive.h"
+#include "cborutil.h"
+#include "task.h"
+#include <QDir>
+#include <QMutexLocker>
+
+bool HistoryArchive::append(const QList<TaskHistoryEntry>& entries, int count, Block& block) {
+    // Своя таблица действий у каждого блока: блок читается без общего контекста
+    QHash<QString, int> actionIds;
+    QStringList actions;
+    for (int i = 0; i < count; i++) {
+        QString action = entries[i].getAction();
+        if (!actionIds.contains(action)) {
+            actionIds.insert(action, actions.size());
+            actions.append(action);
+        }
+    }
+
+    QByteArray payload;
+    QCborStreamWriter writer(&payload);
+    writer.startArray(2);
+    writer.startArray(actions.size());
+    for (const QString& action : actions) {
+        writer.append(action);
+    }
+    writer.endArray();
+    writer.startArray(count);
+    for (int i = 0; i < count; i++) {
+        entries[i].toCbor(writer, actionIds);
+    }
+    writer.endArray();
+    writer.endArray();
+    QByteArray compressed = qCompress(payload); // Текст деталей сжимается в разы
+
+    QMutexLocker locker(&mutex);
+    if (!file.isOpen()) {
+        file.setFileTemplate(QDir::tempPath() + "/scrum-board-history-XXXXXX");
+        if (!file.open()) {
+            return false;
+        }
+    }
+    if (!file.seek(end) || file.write(compressed) != compressed.size() || !file.flush()) {
+        return false;
+    }
+
+    block.offset = end;
+    block.size = compressed.size();
+    block.count = count;
+    end += compressed.size();
+    return true;
+}
+
+bool HistoryArchive::read(const Block& block, QList<TaskHistoryEntry>& entries) const {
+    QByteArray compressed;
+    {
+        QMutexLocker locker(&mutex);
+        if (!file.isOpen() || !file.seek(block.offset)) {
+            return false;
+        }
+        compressed = file.read(block.size);
+    }
+    if (compressed.size() != block.size) {
+        return false;
+    }
+
+    QCborStreamReader reader(qUncompress(compressed));
+    if (!reader.isArray()) {
+        return false;
+    }
+    reader.enterContainer();
+    QStringList actions;
+    if (reader.isArray()) {
+        reader.enterContainer();
+        while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+            actions.append(Cbor::readString(reader));
+        }
+        reader.leaveContainer();
+    }
+    int count = 0;
+    if (reader.isArray()) {
+        reader.enterContainer();
+        while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+            entries.append(TaskHistoryEntry::fromCbor(reader, actions));
+            count++;
+        }
+        reader.leaveContainer();
+    }
+    return reader.lastError() == QCborError::NoError && count == block.count;
+}
+
+qint64 HistoryArchive::size() const {
+    QMutexLocker locker(&mutex);
+    return end;
+}
@@ -0,0 +1,38 @@
+#ifndef HISTORYARCHIVE_H
+#define HISTORYARCHIVE_H
+
+#include <QList>
+#include <QMutex>
+#include <QTemporaryFile>
+
+class TaskHistoryEntry;
+
+// Холодное хранилище старой истории задач: временный файл, в который только дописываются
+// сжатые блоки записей (qCompress поверх CBOR [действия, записи]). Задача помнит свои блоки
+// и читает их, только когда нужна вся история. Файл живет, пока на архив ссылается хоть
+// одна задача (в том числе копии в снимках), и удаляется вместе с ним.
+// Запись и чтение - из любого потока (фоновое сохранение читает архив из рабочего потока)
+class HistoryArchive {
+public:
+    struct Block {
+        qint64 offset = 0;
+        int size = 0;  // Байт на диске
+        int count = 0; // Записей в блоке
+    };
+
+    HistoryArchive() = default;
+    Q_DISABLE_COPY(HistoryArchive)
+
+    // Первые count записей entries одним блоком; false - файл недоступен, записи остаются у вызывающего
+    bool append(const QList<TaskHistoryEntry>& entries, int count, Block& block);
+    // Записи блока дописываются в entries
+    bool read(const Block& block, QList<TaskHistoryEntry>& entries) const;
+    qint64 size() const; // Байт в файле
+
+private:
+    mutable QMutex mutex;
+    mutable QTemporaryFile file; // Создается при первом блоке
+    qint64 end = 0;
+};
+
+#endif // HISTORYARCHIVE_H
@@ -0,0 +1,620 @@
+#include "jsonstream.h"
+#include <QIODevice>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Грамматика числа JSON: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isJsonNumber(const QByteArray& text) {
+    const char* p = text.constData();
+    const char* end = p + text.size();
+    auto digits = [&]() {
+        const char* start = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            p++;
+        }
+        return p - start;
+    };
+
+    if (p < end && *p == '-') {
+        p++;
+    }
+    if (p < end && *p == '0') {
+        p++;
+    } else if (digits() == 0) {
+        return false;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        if (digits() == 0) {
+            return false;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) {
+            p++;
+        }
+        if (digits() == 0) {
+            return false;
+        }
+    }
+    return p == end;
+}
+
+} // namespace
+
+JsonStreamReader::JsonStreamReader(QIODevice* device, int chunkSize)
+    : device(device), chunkSize(chunkSize) {
+}
+
+JsonStreamReader::JsonStreamReader(const QByteArray& data)
+    : device(nullptr), chunkSize(0), buffer(data), firstChunk(false) {
+    if (buffer.startsWith("\xEF\xBB\xBF")) {
+        position = 3; // Метка порядка байт UTF-8
+    }
+}
+
+bool JsonStreamReader::fill() {
+    if (!device) {
+        return false; // Все данные уже в буфере
+    }
+    if (capture) {
+        capture->append(buffer.constData() + captureStart, buffer.size() - captureStart);
+        captureStart = 0;
+    }
+    chunkStart += buffer.size();
+    if (firstChunk) {
+        firstChunk = false;
+        if (device->peek(3) == "\xEF\xBB\xBF") {
+            device->read(3); // Метка порядка байт UTF-8, как ее пропускает QJsonDocument
+            chunkStart += 3;
+        }
+    }
+    buffer = device->read(chunkSize); // Прочитанный кусок освобождается при следующем чтении
+    position = 0;
+    return !buffer.isEmpty();
+}
+
+int JsonStreamReader::peekChar() {
+    if (position >= buffer.size() && !fill()) {
+        return -1;
+    }
+    return static_cast<uchar>(buffer[position]);
+}
+
+void JsonStreamReader::skipWhitespace() {
+    for (;;) {
+        int c = peekChar();
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return;
+        }
+        position++;
+    }
+}
+
+bool JsonStreamReader::expect(char c) {
+    skipWhitespace();
+    if (error || peekChar() != static_cast<uchar>(c)) {
+        fail();
+        return false;
+    }
+    position++;
+    return true;
+}
+
+bool JsonStreamReader::expectWord(const char* word) {
+    skipWhitespace();
+    for (const char* p = word; *p; p++) {
+        if (error || peekChar() != static_cast<uchar>(*p)) {
+            fail();
+            return false;
+        }
+        position++;
+    }
+    return true;
+}
+
+JsonStreamReader::Type JsonStreamReader::peekType() {
+    skipWhitespace();
+    if (error) {
+        return Type::Invalid;
+    }
+    int c = peekChar();
+    switch (c) {
+    case '{': return Type::Object;
+    case '[': return Type::Array;
+    case '"': return Type::String;
+    case 't':
+    case 'f': return Type::Bool;
+    case 'n': return Type::Null;
+    default:
+        return (c == '-' || (c >= '0' && c <= '9')) ? Type::Number : Type::Invalid;
+    }
+}
+
+bool JsonStreamReader::enterContainer(char open) {
+    if (expectingFirst.size() >= MaxDepth) {
+        fail();
+        return false;
+    }
+    if (!expect(open)) {
+        return false;
+    }
+    expectingFirst.append(true);
+    return true;
+}
+
+bool JsonStreamReader::enterObject() {
+    return peekType() == Type::Object && enterContainer('{');
+}
+
+bool JsonStreamReader::enterArray() {
+    return peekType() == Type::Array && enterContainer('[');
+}
+
+// Общая часть nextKey/nextElement: закрывающая скобка или запятая между элементами
+bool JsonStreamReader::beginMember(char close) {
+    skipWhitespace();
+    if (error || expectingFirst.isEmpty()) {
+        fail();
+        return false;
+    }
+    int c = peekChar();
+    if (c == static_cast<uchar>(close)) {
+        position++;
+        expectingFirst.removeLast();
+        return false;
+    }
+    if (!expectingFirst.last()) {
+        if (c != ',') {
+            fail();
+            return false;
+        }
+        position++;
+        skipWhitespace();
+        if (peekChar() == static_cast<uchar>(close)) { // Запятая перед скобкой - ошибка
+            fail();
+            return false;
+        }
+    }
+    expectingFirst.last() = false;
+    return true;
+}
+
+bool JsonStreamReader::nextKey(QString& key) {
+    if (!beginMember('}')) {
+        return false;
+    }
+    if (peekType() != Type::String) {
+        fail();
+        return false;
+    }
+    key = readString();
+    return expect(':');
+}
+
+bool JsonStreamReader::nextElement() {
+    return beginMember(']');
+}
+
+int JsonStreamReader::readHex4() {
+    int value = 0;
+    for (int i = 0; i < 4; i++) {
+        int c = peekChar();
+        int digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            fail();
+            return 0;
+        }
+        position++;
+        value = value * 16 + digit;
+    }
+    return value;
+}
+
+QString JsonStreamReader::readString() {
+    QString result;
+    if (!scanString(&result)) {
+        return QString();
+    }
+    return result;
+}
+
+bool JsonStreamReader::scanString(QString* result) {
+    if (!expect('"')) {
+        return false;
+    }
+
+    // Байты UTF-8 копятся в utf8 (в том числе через границу кусков) и
+    // декодируются разом перед каждой escape-последовательностью и в конце
+    QByteArray utf8;
+    for (;;) {
+        if (position >= buffer.size() && !fill()) {
+            fail(); // Строка не закрыта
+            return false;
+        }
+
+        // Быстрый путь: копируем обычные символы до кавычки или '\' одним куском
+        int start = position;
+        const char* data = buffer.constData();
+        while (position < buffer.size()) {
+            uchar c = static_cast<uchar>(data[position]);
+            if (c == '"' || c == '\\' || c < 0x20) {
+                break;
+            }
+            position++;
+        }
+        if (result) {
+            utf8.append(data + start, position - start);
+        }
+        if (position >= buffer.size()) {
+            continue;
+        }
+
+        uchar c = static_cast<uchar>(data[position++]);
+        if (c == '"') {
+            if (result) {
+                *result += QString::fromUtf8(utf8);
+            }
+            return true;
+        }
+        if (c < 0x20) {
+            fail(); // Управляющие символы внутри строки запрещены
+            return false;
+        }
+
+        // Escape-последовательность
+        QChar unescaped;
+        int escaped = peekChar();
+        position++;
+        switch (escaped) {
+        case '"':  unescaped = QLatin1Char('"'); break;
+        case '\\': unescaped = QLatin1Char('\\'); break;
+        case '/':  unescaped = QLatin1Char('/'); break;
+        case 'b':  unescaped = QLatin1Char('\b'); break;
+        case 'f':  unescaped = QLatin1Char('\f'); break;
+        case 'n':  unescaped = QLatin1Char('\n'); break;
+        case 'r':  unescaped = QLatin1Char('\r'); break;
+        case 't':  unescaped = QLatin1Char('\t'); break;
+        case 'u':  unescaped = QChar(static_cast<ushort>(readHex4())); break; // Суррогатные пары - двумя единицами UTF-16
+        default:
+            fail();
+            return false;
+        }
+        if (error) {
+            return false;
+        }
+        if (result) {
+            *result += QString::fromUtf8(utf8);
+            *result += unescaped;
+            utf8.clear();
+        }
+    }
+}
+
+double JsonStreamReader::readNumber() {
+    if (peekType() != Type::Number) {
+        fail();
+        return 0;
+    }
+    QByteArray text;
+    for (;;) {
+        int c = peekChar();
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')) {
+            break;
+        }
+        text.append(static_cast<char>(c));
+        position++;
+    }
+    bool ok = isJsonNumber(text);
+    double value = ok ? text.toDouble(&ok) : 0;
+    if (!ok) {
+        fail();
+        return 0;
+    }
+    return value;
+}
+
+bool JsonStreamReader::readBool() {
+    if (peekChar() == 't') {
+        return expectWord("true");
+    }
+    expectWord("false");
+    return false;
+}
+
+void JsonStreamReader::readNull() {
+    expectWord("null");
+}
+
+void JsonStreamReader::skipValue() {
+    switch (peekType()) {
+    case Type::Object:
+        enterObject();
+        while (beginMember('}')) { // Ключи проверяются, но не декодируются
+            if (peekChar() != '"' || !scanString(nullptr) || !expect(':')) {
+                fail();
+                break;
+            }
+            skipValue();
+        }
+        break;
+    case Type::Array:
+        enterArray();
+        while (nextElement()) {
+            skipValue();
+        }
+        break;
+    case Type::String: scanString(nullptr); break;
+    case Type::Number: readNumber(); break;
+    case Type::Bool:   readBool(); break;
+    case Type::Null:   readNull(); break;
+    case Type::Invalid:
+        fail();
+        break;
+    }
+}
+
+QByteArray JsonStreamReader::readRawValue(int* elementCount) {
+    int count = 0;
+    if (elementCount) {
+        *elementCount = 0;
+    }
+    skipWhitespace();
+    if (error) {
+        return QByteArray();
+    }
+
+    QByteArray raw;
+    capture = &raw;
+    captureStart = position;
+    if (elementCount && peekType() == Type::Array) {
+        enterArray();
+        while (nextElement()) {
+            skipValue();
+            count++;
+        }
+    } else {
+        skipValue();
+    }
+    capture = nullptr;
+    if (error) {
+        return QByteArray();
+    }
+
+    raw.append(buffer.constData() + captureStart, position - captureStart);
+    if (elementCount) {
+        *elementCount = count;
+    }
+    return raw;
+}
+
+QString JsonStreamReader::toString() {
+    if (peekType() != Type::String) {
+        skipValue();
+        return QString();
+    }
+    return readString();
+}
+
+int JsonStreamReader::toInt(int fallback) {
+    if (peekType() != Type::Number) {
+        skipValue();
+        return fallback;
+    }
+    double value = readNumber();
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()
+        || static_cast<int>(value) != value) {
+        return fallback; // Дробное или слишком большое - как QJsonValue::toInt
+    }
+    return static_cast<int>(value);
+}
+
+qint64 JsonStreamReader::toInt64(qint64 fallback) {
+    if (peekType() != Type::Number) {
+        skipValue();
+        return fallback;
+    }
+    double value = readNumber();
+    if (std::abs(value) > 9007199254740992.0 || std::trunc(value) != value) { // 2^53
+        return fallback;
+    }
+    return static_cast<qint64>(value);
+}
+
+bool JsonStreamReader::atEnd() {
+    skipWhitespace();
+    return !error && peekChar() == -1;
+}
+
+JsonStreamWriter::JsonStreamWriter(QIODevice* device, QJsonDocument::JsonFormat format, int chunkSize)
+    : device(device), compact(format == QJsonDocument::Compact), chunkSize(chunkSize) {
+    buffer.reserve(chunkSize + 1024);
+}
+
+bool JsonStreamWriter::flush() {
+    if (!buffer.isEmpty() && !error) {
+        error = device->write(buffer) != buffer.size();
+    }
+    buffer.clear(); // reserve сохраняется: буфер не перевыделяется между кусками
+    return !error;
+}
+
+// Разделитель и отступ перед элементом массива или ключом объекта
+void JsonStreamWriter::beginValue() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (counts.isEmpty()) {
+        return; // Корневое значение
+    }
+    if (counts.last() > 0) {
+        buffer.append(compact ? "," : ",\n");
+    }
+    if (!compact) {
+        indent(counts.size());
+    }
+    counts.last()++;
+}
+
+void JsonStreamWriter::open(char bracket) {
+    beginValue();
+    buffer.append(bracket);
+    if (!compact) {
+        buffer.append('\n');
+    }
+    counts.append(0);
+}
+
+void JsonStreamWriter::close(char bracket) {
+    if (!compact && counts.last() > 0) {
+        buffer.append('\n');
+    }
+    counts.removeLast();
+    if (!compact) {
+        indent(counts.size());
+    }
+    buffer.append(bracket);
+    if (counts.isEmpty()) {
+        if (!compact) {
+            buffer.append('\n'); // QJsonDocument завершает документ переводом строки
+        }
+        flush();
+    } else {
+        flushIfFull();
+    }
+}
+
+void JsonStreamWriter::startObject() {
+    open('{');
+}
+
+void JsonStreamWriter::endObject() {
+    close('}');
+}
+
+void JsonStreamWriter::startArray() {
+    open('[');
+}
+
+void JsonStreamWriter::endArray() {
+    close(']');
+}
+
+void JsonStreamWriter::writeKey(const char* key) {
+    beginValue();
+    buffer.append('"');
+    buffer.append(key);
+    buffer.append(compact ? "\":" : "\": ");
+    afterKey = true;
+}
+
+void JsonStreamWriter::writeString(const QString& value) {
+    beginValue();
+    QByteArray utf8 = value.toUtf8();
+    buffer.append('"');
+
+    // Экранирование как в QJsonDocument: кавычка, '\\' и управляющие символы
+    static const char hex[] = "0123456789abcdef";
+    const char* data = utf8.constData();
+    int start = 0;
+    for (int i = 0; i < utf8.size(); i++) {
+        uchar c = static_cast<uchar>(data[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        buffer.append(data + start, i - start);
+        start = i + 1;
+        buffer.append('\\');
+        switch (c) {
+        case '"':  buffer.append('"'); break;
+        case '\\': buffer.append('\\'); break;
+        case '\b': buffer.append('b'); break;
+        case '\f': buffer.append('f'); break;
+        case '\n': buffer.append('n'); break;
+        case '\r': buffer.append('r'); break;
+        case '\t': buffer.append('t'); break;
+        default:
+            buffer.append("u00");
+            buffer.append(hex[c >> 4]);
+            buffer.append(hex[c & 0xf]);
+            break;
+        }
+    }
+    buffer.append(data + start, utf8.size() - start);
+
+    buffer.append('"');
+    flushIfFull();
+}
+
+void JsonStreamWriter::writeInt(qint64 value) {
+    beginValue();
+    buffer.append(QByteArray::number(value));
+}
+
+void JsonStreamWriter::writeBool(bool value) {
+    beginValue();
+    buffer.append(value ? "true" : "false");
+}
+
+void JsonStreamWriter::writeNull() {
+    beginValue();
+    buffer.append("null");
+}
+
+// Текст проверен при чтении (readRawValue), поэтому достаточно разбить его на лексемы:
+// скобки, ':' и значения идут через open/close/beginValue, как у обычной записи
+void JsonStreamWriter::writeRawElements(const QByteArray& array) {
+    const char* data = array.constData();
+    int size = array.size();
+    int depth = 0; // Вложенность внутри текста: внешние скобки массива не пишутся
+    for (int i = 0; i < size;) {
+        char c = data[i];
+        if (c == '[' || c == '{') {
+            if (depth > 0) {
+                open(c);
+            }
+            depth++;
+            i++;
+        } else if (c == ']' || c == '}') {
+            depth--;
+            if (depth > 0) {
+                close(c);
+            }
+            i++;
+        } else if (c == ':') {
+            buffer.append(compact ? ":" : ": ");
+            afterKey = true;
+            i++;
+        } else if (c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            i++;
+        } else {
+            int start = i;
+            if (c == '"') {
+                for (i++; i < size && data[i] != '"'; i++) {
+                    if (data[i] == '\\') {
+                        i++; // Экранированный символ, в том числе кавычка
+                    }
+                }
+                i++;
+            } else {
+                while (i < size && data[i] != ',' && data[i] != ']' && data[i] != '}' && data[i] != ':'
+                       && data[i] != ' ' && data[i] != '\t' && data[i] != '\n' && data[i] != '\r') {
+                    i++;
+                }
+            }
+            beginValue(); // Строка-ключ тоже: запятая и отступ перед ней - как у writeKey
+            buffer.append(data + start, i - start);
+            flushIfFull();
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef JSONSTREAM_H
+#define JSONSTREAM_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QJsonDocument> // QJsonDocument::JsonFormat
+
+class QIODevice;
+
+// Потоковое (pull) чтение JSON без построения QJsonDocument.
+// Данные читаются с устройства кусками, значения разбираются по мере запроса:
+//
+//   if (reader.enterObject()) {
+//       QString key;
+//       while (reader.nextKey(key)) {
+//           if (key == "id") id = reader.toInt(); else reader.skipValue();
+//       }
+//   }
+//
+// После ошибки синтаксиса все методы возвращают пустые значения, а циклы
+// nextKey/nextElement завершаются - достаточно проверить hasError() в конце.
+class JsonStreamReader {
+public:
+    enum class Type {
+        Invalid, // Ошибка или конец данных
+        Object,
+        Array,
+        String,
+        Number,
+        Bool,
+        Null
+    };
+
+    explicit JsonStreamReader(QIODevice* device, int chunkSize = 64 * 1024);
+    explicit JsonStreamReader(const QByteArray& data); // Данные уже в памяти (без копирования для fromRawData)
+
+    Type peekType(); // Тип следующего значения (пробелы пропускаются)
+
+    bool enterObject();         // false - следующее значение не объект
+    bool nextKey(QString& key); // Ключ следующего поля; false - объект закончился
+    bool enterArray();
+    bool nextElement();         // true - дальше идет элемент; false - массив закончился
+
+    QString readString();
+    double readNumber();
+    bool readBool();
+    void readNull();
+    void skipValue(); // Пропустить значение любого типа вместе с вложенными
+    // Пропустить значение и вернуть его исходный текст (с проверкой синтаксиса, без разбора).
+    // elementCount - число элементов, если значение - массив
+    QByteArray readRawValue(int* elementCount = nullptr);
+
+    // Преобразования как у QJsonValue: значение другого типа пропускается
+    QString toString();
+    int toInt(int fallback = 0); // Только целые числа в диапазоне int
+    qint64 toInt64(qint64 fallback = 0); // Целые числа, точно представимые в double (как idFromJson)
+
+    bool atEnd(); // После значения остались только пробелы
+    qint64 offset() const { return chunkStart + position; } // Позиция в байтах от начала данных
+    bool hasError() const { return error; }
+
+private:
+    static constexpr int MaxDepth = 1024; // Как у QJsonDocument
+
+    QIODevice* device;
+    int chunkSize;
+    QByteArray buffer;
+    int position = 0;
+    qint64 chunkStart = 0; // Смещение текущего куска от начала данных
+    bool error = false;
+    bool firstChunk = true;
+    QVector<bool> expectingFirst; // Стек контейнеров: еще не было ни одного элемента
+    QByteArray* capture = nullptr; // readRawValue: сюда уходит текст кусков, которые освобождает fill
+    int captureStart = 0;
+
+    bool fill();
+    int peekChar(); // -1 - данные кончились
+    void skipWhitespace();
+    bool expect(char c);
+    bool expectWord(const char* word);
+    bool enterContainer(char open);
+    bool beginMember(char close);
+    int readHex4();
+    bool scanString(QString* result); // nullptr - только проверить и пропустить
+    void fail() { error = true; }
+};
+
+// Потоковая запись JSON без QJsonObject/QJsonDocument.
+// Текст копится в буфере и уходит на устройство кусками по chunkSize байт.
+// Формат совпадает с QJsonDocument::toJson байт в байт (отступ 4 пробела,
+// экранирование как в Qt), если ключи объектов пишутся в алфавитном порядке -
+// так их упорядочивает QJsonObject.
+class JsonStreamWriter {
+public:
+    explicit JsonStreamWriter(QIODevice* device, QJsonDocument::JsonFormat format = QJsonDocument::Indented,
+                              int chunkSize = 64 * 1024);
+    ~JsonStreamWriter() { flush(); }
+
+    void startObject();
+    void endObject();
+    void startArray();
+    void endArray();
+
+    void writeKey(const char* key); // Ключи - ASCII без экранирования
+    void writeString(const QString& value);
+    void writeInt(qint64 value);
+    void writeBool(bool value);
+    void writeNull();
+    // Элементы массива из готового текста (readRawValue) - в уже открытый массив, без разбора значений.
+    // Пробелы исходного текста отбрасываются, отступы ставятся по текущей глубине и формату
+    void writeRawElements(const QByteArray& array);
+
+    // Ключ и значение одним вызовом
+    void writeMember(const char* key, const QString& value) { writeKey(key); writeString(value); }
+    void writeMember(const char* key, qint64 value) { writeKey(key); writeInt(value); }
+    void writeMember(const char* key, int value) { writeKey(key); writeInt(value); }
+
+    bool flush(); // false - устройство не приняло данные
+    bool hasError() const { return error; }
+
+private:
+    QIODevice* device;
+    bool compact;
+    int chunkSize;
+    QByteArray buffer;
+    QVector<int> counts; // Стек контейнеров: сколько элементов уже записано
+    bool afterKey = false; // Следующее значение идет сразу после ключа
+    bool error = false;
+
+    void beginValue();
+    void open(char bracket);
+    void close(char bracket);
+    void indent(int depth) { buffer.append(depth * 4, ' '); }
+    void flushIfFull() {
+        if (buffer.size() >= chunkSize) {
+            flush();
+        }
+    }
+};
+
+#endif // JSONSTREAM_H
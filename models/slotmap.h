@@ -0,0 +1,249 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <deque>       // Сегментированное хранилище: push_back не перемещает существующие элементы
+#include <optional>
+#include <iterator>
+#include <type_traits>
+
+// Дескриптор элемента в SlotMap: индекс слота + поколение.
+// Поколение уникально для каждой вставки, поэтому дескриптор удаленного
+// элемента никогда не совпадет с элементом, занявшим тот же слот позже.
+struct SlotHandle {
+    quint32 index = 0;
+    quint32 generation = 0; // 0 - пустой дескриптор
+
+    bool isNull() const { return generation == 0; }
+    bool operator==(const SlotHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Хранилище со стабильными адресами элементов.
+// Элементы живут в std::deque (сегменты не перемещаются при росте), освобожденные
+// слоты переиспользуются через free-list. Порядок вставки хранится отдельно,
+// удаление оставляет "надгробие" в порядке, которое убирается пакетно.
+// Пока жив хоть один итератор, порядок не уплотняется: удаление внутри обхода безопасно.
+// Доступ по позиции - через дерево Фенвика над живыми позициями порядка, O(log n) и с надгробиями
+template <typename T>
+class SlotMap {
+    struct Slot {
+        std::optional<T> value;
+        quint32 generation = 0; // 0 - слот свободен
+        int position = 0;       // Позиция в order
+    };
+
+    // Число живых итераторов. Не копируется вместе с хранилищем: итераторы копии на нее не ссылаются
+    struct IteratorCount {
+        int value = 0;
+        IteratorCount() = default;
+        IteratorCount(const IteratorCount&) {}
+        IteratorCount& operator=(const IteratorCount&) { return *this; }
+    };
+
+public:
+    template <bool IsConst>
+    class Iterator {
+        using Map = std::conditional_t<IsConst, const SlotMap, SlotMap>;
+        using Value = std::conditional_t<IsConst, const T, T>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator(Map* map, int position) : map(map), position(position) {
+            map->iterators.value++;
+            skipStale();
+        }
+        Iterator(const Iterator& other) : map(other.map), position(other.position) { map->iterators.value++; }
+        Iterator& operator=(const Iterator& other) {
+            other.map->iterators.value++;
+            map->iterators.value--;
+            map = other.map;
+            position = other.position;
+            return *this;
+        }
+        ~Iterator() { map->iterators.value--; }
+
+        reference operator*() const { return *map->slots[map->order[position].index].value; }
+        pointer operator->() const { return &**this; }
+        SlotHandle handle() const { return map->order[position]; }
+
+        Iterator& operator++() {
+            ++position;
+            skipStale();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+
+    private:
+        Map* map;
+        int position;
+
+        void skipStale() { // Пропускаем надгробия удаленных элементов
+            while (position < map->order.size() && !map->contains(map->order[position])) {
+                ++position;
+            }
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // Новый обход - удобный момент убрать накопившиеся надгробия (если других обходов нет)
+    iterator begin() { compactIfIdle(); return iterator(this, 0); }
+    iterator end() { return iterator(this, order.size()); }
+    const_iterator begin() const { compactIfIdle(); return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, order.size()); }
+
+    int size() const { return liveCount; }
+    bool isEmpty() const { return liveCount == 0; }
+
+    // Доступ по позиции среди живых элементов в порядке вставки: O(1) без надгробий, иначе O(log n).
+    // Порядок не меняет, поэтому вызывается и внутри обхода
+    T& operator[](int i) { return *slots[handleAt(i).index].value; }
+    const T& operator[](int i) const { return *slots[handleAt(i).index].value; }
+
+    SlotHandle handleAt(int i) const {
+        if (staleCount == 0) {
+            return order[i];
+        }
+        // Спуск по дереву: последняя позиция, до которой (включительно) живых не больше i
+        int position = 0;
+        int remaining = i + 1;
+        for (int step = highestBit(order.size()); step > 0; step >>= 1) {
+            int next = position + step;
+            if (next <= order.size() && liveTree[next] < remaining) {
+                position = next;
+                remaining -= liveTree[next];
+            }
+        }
+        return order[position]; // Индекс 1-based дерева position + 1 - это order[position]
+    }
+
+    bool contains(SlotHandle handle) const {
+        return handle.generation != 0
+               && handle.index < slots.size()
+               && slots[handle.index].generation == handle.generation;
+    }
+
+    // nullptr, если элемент уже удален
+    T* get(SlotHandle handle) { return contains(handle) ? &*slots[handle.index].value : nullptr; }
+    const T* get(SlotHandle handle) const { return contains(handle) ? &*slots[handle.index].value : nullptr; }
+
+    SlotHandle insert(const T& value) {
+        quint32 index;
+        if (!freeSlots.isEmpty()) {
+            index = freeSlots.takeLast();
+        } else {
+            index = static_cast<quint32>(slots.size());
+            slots.emplace_back();
+        }
+
+        Slot& slot = slots[index];
+        slot.value.emplace(value);
+        slot.generation = nextGeneration++;
+        if (nextGeneration == 0) { // Переполнение: 0 зарезервирован под пустой дескриптор
+            nextGeneration = 1;
+        }
+        slot.position = order.size();
+
+        SlotHandle handle;
+        handle.index = index;
+        handle.generation = slot.generation;
+        order.append(handle);
+        appendLive();
+        liveCount++;
+        return handle;
+    }
+
+    bool remove(SlotHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        Slot& slot = slots[handle.index];
+        slot.value.reset();
+        slot.generation = 0;
+        freeSlots.append(handle.index);
+        for (int i = slot.position + 1; i <= order.size(); i += i & -i) {
+            liveTree[i]--;
+        }
+        liveCount--;
+        staleCount++;
+        compactIfIdle();
+        return true;
+    }
+
+    void clear() { // nextGeneration не сбрасывается, чтобы старые дескрипторы остались невалидными
+        slots.clear();
+        freeSlots.clear();
+        order.clear();
+        liveTree.fill(0, 1);
+        liveCount = 0;
+        staleCount = 0;
+    }
+
+private:
+    mutable std::deque<Slot> slots; // mutable: уплотнение в const begin() обновляет позиции слотов
+    QVector<quint32> freeSlots;
+    mutable QVector<SlotHandle> order; // Порядок вставки (может содержать надгробия)
+    mutable QVector<int> liveTree = QVector<int>(1, 0); // Дерево Фенвика (1-based): живые элементы order
+    mutable int staleCount = 0;
+    mutable IteratorCount iterators;
+    int liveCount = 0;
+    quint32 nextGeneration = 1;
+
+    static int highestBit(int n) {
+        int bit = 1;
+        while (bit * 2 <= n) {
+            bit *= 2;
+        }
+        return n > 0 ? bit : 0;
+    }
+
+    int livePrefix(int n) const { // Живых среди первых n позиций order
+        int sum = 0;
+        for (; n > 0; n -= n & -n) {
+            sum += liveTree[n];
+        }
+        return sum;
+    }
+
+    void appendLive() { // Узел новой последней позиции: сама позиция плюс отрезок, который он покрывает
+        int n = order.size();
+        liveTree.append(1 + livePrefix(n - 1) - livePrefix(n - (n & -n)));
+    }
+
+    // Амортизированное уплотнение: надгробий не больше, чем живых элементов, и ни одного живого итератора
+    void compactIfIdle() const {
+        if (staleCount <= 32 || staleCount <= liveCount || iterators.value > 0) {
+            return;
+        }
+        int write = 0;
+        for (int read = 0; read < order.size(); read++) {
+            if (contains(order[read])) {
+                slots[order[read].index].position = write;
+                order[write++] = order[read];
+            }
+        }
+        order.resize(write);
+        liveTree.fill(0, write + 1);
+        for (int i = 1; i <= write; i++) { // Построение за O(n)
+            liveTree[i]++;
+            int parent = i + (i & -i);
+            if (parent <= write) {
+                liveTree[parent] += liveTree[i];
+            }
+        }
+        staleCount = 0;
+    }
+};
+
+#endif // SLOTMAP_H
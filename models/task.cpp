@@ -1,91 +1,271 @@
 #include "task.h"
+#include "cborutil.h"
+#include "jsonstream.h"
 #include <QJsonArray>
+#include <QReadWriteLock>
 
-int Task::nextId = 1;
+namespace {
 
+// Общая таблица действий записей Custom: одна строка на все задачи и доски.
+// Пополняется и из потоков параллельной загрузки. Номер 0 - пустое действие:
+// его получают записи по умолчанию (в том числе из испорченных элементов файла)
+QReadWriteLock actionsLock;
+QStringList actionTable{QString()};
+QHash<QString, quint32> actionNumbers{{QString(), 0}};
+
+quint32 internAction(const QString& action) {
+    {
+        QReadLocker locker(&actionsLock);
+        auto it = actionNumbers.constFind(action);
+        if (it != actionNumbers.constEnd()) {
+            return *it;
+        }
+    }
+    QWriteLocker locker(&actionsLock);
+    auto it = actionNumbers.constFind(action); // Могли добавить между блокировками
+    if (it != actionNumbers.constEnd()) {
+        return *it;
+    }
+    quint32 number = quint32(actionTable.size());
+    actionTable.append(action);
+    actionNumbers.insert(action, number);
+    return number;
+}
+
+QString internedAction(quint32 number) {
+    QReadLocker locker(&actionsLock);
+    return actionTable.value(int(number));
+}
+
+// Текст действия известного события (Custom - пустая строка)
+QString eventAction(HistoryEvent event) {
+    switch (event) {
+    case HistoryEvent::Created:            return QStringLiteral("Создание");
+    case HistoryEvent::TitleChanged:       return QStringLiteral("Изменение названия");
+    case HistoryEvent::DescriptionChanged: return QStringLiteral("Изменение описания");
+    case HistoryEvent::StatusChanged:      return QStringLiteral("Смена статуса");
+    case HistoryEvent::Assigned:           return QStringLiteral("Назначение");
+    case HistoryEvent::Unassigned:         return QStringLiteral("Снятие назначения");
+    case HistoryEvent::DeadlineChanged:    return QStringLiteral("Изменение дедлайна");
+    default:                               return QString();
+    }
+}
+
+const QString TitleArrow = QStringLiteral("' → '");
+const QString StatusArrow = QStringLiteral(" → ");
+const QString AssignedPrefix = QStringLiteral("Назначен разработчик ID: ");
+const QString DeadlinePrefix = QStringLiteral("Установлен дедлайн: ");
+const QString DeadlineFormat = QStringLiteral("dd.MM.yyyy");
+
+} // namespace
+
+// Пустая задача без ID и без истории: так создаются временные объекты при загрузке.
+// ID выдает доска в addTask
 Task::Task()
-    : id(nextId++),
-    title(""),
+    : title(""),
     description(""),
     status(TaskStatus::Backlog), //Начальный статус - Backlog
     assignedDeveloperId(-1) { //задача не назначена
-    addHistoryEntry("Создание", "Задача создана");
 }
 
 Task::Task(const QString& title, const QString& description)
-    : id(nextId++),
-    title(title),
+    : title(title),
     description(description),
     status(TaskStatus::Backlog),
     assignedDeveloperId(-1) {
-    addHistoryEntry("Создание", QString("Задача '%1' создана").arg(title));
+    appendHistory(TaskHistoryEntry::created(title));
 }
 
 void Task::setTitle(const QString& newTitle) {
     if (title != newTitle) {
-        addHistoryEntry("Изменение названия", QString("'%1' → '%2'").arg(title, newTitle));
+        appendHistory(TaskHistoryEntry::titleChanged(title, newTitle));
         title = newTitle;
+        notifyEdited(TaskField::Title);
     }
 }
 
 void Task::setDescription(const QString& newDescription) {
     if (description != newDescription) {
-        addHistoryEntry("Изменение описания", "Описание обновлено");
+        appendHistory(TaskHistoryEntry::descriptionChanged());
         description = newDescription;
+        notifyEdited(TaskField::Description);
     }
 }
 
 void Task::setStatus(TaskStatus newStatus) {
     if (status != newStatus) {
-        addHistoryEntry("Смена статуса",
-                        QString("%1 → %2").arg(statusToString(status), statusToString(newStatus)));
+        appendHistory(TaskHistoryEntry::statusChanged(status, newStatus));
+        TaskStatus oldStatus = status;
         status = newStatus;
+        if (boardLink.observer) { // Сообщаем доске, чтобы она обновила индекс статусов
+            boardLink.observer->taskStatusChanged(this, oldStatus);
+        }
+        notifyEdited(TaskField::Status);
     }
 }
 
-void Task::assignToDeveloper(int developerId) {
+void Task::assignToDeveloper(DeveloperId developerId) {
     if (assignedDeveloperId != developerId) {
-        addHistoryEntry("Назначение", QString("Назначен разработчик ID: %1").arg(developerId));
+        appendHistory(TaskHistoryEntry::assigned(developerId));
+        DeveloperId oldDeveloperId = assignedDeveloperId;
         assignedDeveloperId = developerId;
+        if (boardLink.observer) { // Доска переносит задачу в индексе разработчиков
+            boardLink.observer->taskAssigneeChanged(this, oldDeveloperId);
+        }
+        notifyEdited(TaskField::Assignee);
     }
 }
 
 void Task::unassign() {
     if (assignedDeveloperId != -1) {
-        addHistoryEntry("Снятие назначения", "Разработчик снят с задачи");
+        appendHistory(TaskHistoryEntry::unassigned());
+        DeveloperId oldDeveloperId = assignedDeveloperId;
         assignedDeveloperId = -1;
+        if (boardLink.observer) {
+            boardLink.observer->taskAssigneeChanged(this, oldDeveloperId);
+        }
+        notifyEdited(TaskField::Assignee);
     }
 }
 
 void Task::setDeadline(const QDateTime& newDeadline) {
     if (deadline != newDeadline) {
-        QString details = newDeadline.isValid() //isValid() для проверки корректности даты
-        ? QString("Установлен дедлайн: %1").arg(newDeadline.toString("dd.MM.yyyy"))
-        : "Дедлайн удален";
-        addHistoryEntry("Изменение дедлайна", details);
+        appendHistory(TaskHistoryEntry::deadlineChanged(newDeadline));
         deadline = newDeadline;
+        notifyEdited(TaskField::Deadline);
+    }
+}
+
+void Task::notifyEdited(TaskField field) {
+    if (boardLink.observer) {
+        boardLink.observer->taskEdited(this, field);
     }
 }
 
+void Task::attachToBoard(TaskObserver* observer, quint64 sequence) {
+    boardLink.observer = observer;
+    boardLink.sequence = sequence;
+}
+
 int Task::daysUntilDeadline() const {
-    if (!deadline.isValid()) return 999;
-    return QDateTime::currentDateTime().daysTo(deadline);
+    return daysUntilDeadline(QDateTime::currentDateTime());
 }
 
 bool Task::isOverdue() const {
+    return isOverdue(QDateTime::currentDateTime());
+}
+
+int Task::daysUntilDeadline(const QDateTime& now) const {
+    if (!deadline.isValid()) return 999;
+    return now.daysTo(deadline);
+}
+
+bool Task::isOverdue(const QDateTime& now) const {
     if (!deadline.isValid()) return false;
-    return QDateTime::currentDateTime() > deadline && status != TaskStatus::Done; //Возвращает true если: Дедлайн установлен, текущее время позже дедлайна, задача не в статусе Done
+    return now > deadline && status != TaskStatus::Done; //Возвращает true если: Дедлайн установлен, текущее время позже дедлайна, задача не в статусе Done
 }
 
-void Task::addHistoryEntry(const QString& action, const QString& details) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = action;
-    entry.details = details;
+// Каждое изменение полей задачи проходит через историю, поэтому здесь же растет ревизия
+void Task::appendHistory(const TaskHistoryEntry& entry) {
+    revision++;
     history.append(entry);
-} 
+    if (historyLimit > 0 && history.size() > historyLimit) {
+        spillHistory();
+    }
+}
+
+// Лимит касается только окна: загруженная из JSON история остается текстом и не разбирается
+void Task::limitHistory(int limit, const std::shared_ptr<HistoryArchive>& archive) {
+    historyLimit = limit;
+    if (!historyArchive) {
+        historyArchive = archive;
+    }
+    if (historyLimit > 0 && history.size() > historyLimit) {
+        spillHistory();
+    }
+}
+
+// Окно освобождается наполовину за раз: один блок на limit/2 записей, сдвиг окна - амортизированно O(1).
+// В окне всегда остается хотя бы последняя запись (ее читают журнал и replaceLastHistoryEntry)
+void Task::spillHistory() {
+    int keep = historyLimit - historyLimit / 2;
+    int count = history.size() - keep;
+    HistoryArchive::Block block;
+    if (!historyArchive || count <= 0 || !historyArchive->append(history, count, block)) {
+        historyLimit = 0; // Архив недоступен: история остается в памяти целиком
+        return;
+    }
+    archivedBlocks.append(block);
+    archivedCount += count;
+    history.erase(history.begin(), history.begin() + count);
+}
+
+QList<TaskHistoryEntry> Task::getHistory(bool* ok) const {
+    if (loadedHistoryCount == 0 && archivedBlocks.isEmpty()) {
+        if (ok) {
+            *ok = true;
+        }
+        return history;
+    }
+    QList<TaskHistoryEntry> result;
+    result.reserve(getHistorySize());
+    bool complete = forEachHistoryEntry([&result](const TaskHistoryEntry& entry) {
+        result.append(entry);
+    });
+    if (ok) {
+        *ok = complete;
+    }
+    return result;
+}
 
-QJsonObject Task::toJson() const {
+bool Task::forEachHistoryEntry(const std::function<void(const TaskHistoryEntry&)>& visit) const {
+    forEachLoadedEntry(visit);
+    return forEachStoredEntry(visit);
+}
+
+// Записи разбираются по одной и не сохраняются: память не растет, задача не меняется
+void Task::forEachLoadedEntry(const std::function<void(const TaskHistoryEntry&)>& visit) const {
+    if (!loadedHistoryText.isEmpty()) {
+        JsonStreamReader reader(loadedHistoryText); // Синтаксис проверен при загрузке
+        if (reader.enterArray()) {
+            while (reader.nextElement()) {
+                visit(TaskHistoryEntry::fromJsonStream(reader));
+            }
+        }
+    }
+    for (const QJsonValue& value : loadedHistoryArray) {
+        visit(TaskHistoryEntry::fromJson(value.toObject()));
+    }
+}
+
+bool Task::forEachStoredEntry(const std::function<void(const TaskHistoryEntry&)>& visit) const {
+    for (const HistoryArchive::Block& block : archivedBlocks) {
+        QList<TaskHistoryEntry> entries;
+        entries.reserve(block.count);
+        if (!historyArchive->read(block, entries)) {
+            return false; // Пропуск блока незаметно укоротил бы историю
+        }
+        for (const TaskHistoryEntry& entry : entries) {
+            visit(entry);
+        }
+    }
+    for (const TaskHistoryEntry& entry : history) {
+        visit(entry);
+    }
+    return true;
+}
+
+void Task::addHistoryEntry(const QString& action, const QString& details) {
+    appendHistory(TaskHistoryEntry(QDateTime::currentDateTime(), action, details));
+}
+
+void Task::replaceLastHistoryEntry(const TaskHistoryEntry& entry) {
+    if (!history.isEmpty()) {
+        history.last() = entry;
+    }
+}
+
+QJsonObject Task::toJson(bool* ok) const {
     QJsonObject json; //Создает JSON-объект со всеми данными задачи
     json["id"] = id;
     json["title"] = title;
@@ -94,41 +274,173 @@ QJsonObject Task::toJson() const {
     json["assignedDeveloperId"] = assignedDeveloperId;
     json["deadline"] = deadline.isValid() ? deadline.toString(Qt::ISODate) : ""; //стандарт ISO для дат
 
-    QJsonArray historyArray;
-    for (const TaskHistoryEntry& entry : history) {
+    QJsonArray historyArray = loadedHistoryArray; // Не разобранный массив - без изменений
+    auto append = [&historyArray](const TaskHistoryEntry& entry) {
         historyArray.append(entry.toJson());
+    };
+    if (loadedHistoryArray.isEmpty()) {
+        forEachLoadedEntry(append);
     }
+    bool complete = forEachStoredEntry(append);
     json["history"] = historyArray;
+    if (ok) {
+        *ok = complete;
+    }
 
     return json; //Сохраняет всю историю как массив JSON-объектов
 }
 
 Task Task::fromJson(const QJsonObject& json) {
     Task task; // Создает временный объект Task с помощью конструктора 
-    task.id = json["id"].toInt();
+    task.id = idFromJson(json["id"]);
     task.title = json["title"].toString();
     task.description = json["description"].toString();
     task.status = stringToStatus(json["status"].toString());
-    task.assignedDeveloperId = json["assignedDeveloperId"].toInt();
+    task.assignedDeveloperId = idFromJson(json["assignedDeveloperId"]);
 
     QString deadlineStr = json["deadline"].toString(); //Обрабатывает дедлайн (пустая строка = нет дедлайна)
     if (!deadlineStr.isEmpty()) {
         task.deadline = QDateTime::fromString(deadlineStr, Qt::ISODate);
     }
 
-    task.history.clear();
-    QJsonArray historyArray = json["history"].toArray(); //Восстанавливает историю из JSON-массива
-    for (const QJsonValue& value : historyArray) {
-        task.history.append(TaskHistoryEntry::fromJson(value.toObject()));
+    // История не разбирается: массив остается как есть и разбирается при обходе (forEachHistoryEntry)
+    task.loadedHistoryArray = json["history"].toArray();
+    task.loadedHistoryCount = task.loadedHistoryArray.size();
+
+    return task; // ID резервирует доска при добавлении задачи
+}
+
+bool Task::toJsonStream(JsonStreamWriter& writer) const {
+    writer.startObject(); // Ключи по алфавиту, как их упорядочивает QJsonObject
+    writer.writeMember("assignedDeveloperId", assignedDeveloperId);
+    writer.writeMember("deadline", deadline.isValid() ? deadline.toString(Qt::ISODate) : QString());
+    writer.writeMember("description", description);
+
+    writer.writeKey("history");
+    writer.startArray();
+    // Загруженный текст переносится без разбора записей, с отступами текущей глубины
+    writer.writeRawElements(loadedHistoryText);
+    for (const QJsonValue& value : loadedHistoryArray) {
+        TaskHistoryEntry::fromJson(value.toObject()).toJsonStream(writer);
+    }
+    bool complete = forEachStoredEntry([&writer](const TaskHistoryEntry& entry) {
+        entry.toJsonStream(writer);
+    });
+    writer.endArray();
+
+    writer.writeMember("id", id);
+    writer.writeMember("status", statusToString(status));
+    writer.writeMember("title", title);
+    writer.endObject();
+    return complete;
+}
+
+Task Task::fromJsonStream(JsonStreamReader& reader) {
+    Task task;
+    task.assignedDeveloperId = 0; // Отсутствующие поля - как у fromJson для пустого объекта
+    if (!reader.enterObject()) {
+        reader.skipValue();
+        return task;
     }
 
-    if (task.id >= nextId) { 
-        nextId = task.id + 1; //Обновляет статический nextId если загруженный ID больше текущего
+    QString key;
+    while (reader.nextKey(key)) {
+        if (key == QLatin1String("id")) {
+            task.id = reader.toInt64();
+        } else if (key == QLatin1String("title")) {
+            task.title = reader.toString();
+        } else if (key == QLatin1String("description")) {
+            task.description = reader.toString();
+        } else if (key == QLatin1String("status")) {
+            task.status = stringToStatus(reader.toString());
+        } else if (key == QLatin1String("assignedDeveloperId")) {
+            task.assignedDeveloperId = reader.toInt64();
+        } else if (key == QLatin1String("deadline")) {
+            QString deadlineStr = reader.toString();
+            task.deadline = deadlineStr.isEmpty() ? QDateTime() : QDateTime::fromString(deadlineStr, Qt::ISODate);
+        } else if (key == QLatin1String("history")) {
+            // Записи не разбираются: хранится текст массива, синтаксис проверяется сейчас.
+            // При повторе ключа побеждает последнее значение
+            task.loadedHistoryText.clear();
+            task.loadedHistoryCount = 0;
+            if (reader.peekType() == JsonStreamReader::Type::Array) {
+                int count = 0;
+                QByteArray text = reader.readRawValue(&count);
+                if (count > 0) {
+                    task.loadedHistoryText = text;
+                    task.loadedHistoryCount = count;
+                }
+            } else {
+                reader.skipValue();
+            }
+        } else {
+            reader.skipValue();
+        }
     }
 
     return task;
 }
 
+void Task::collectHistoryActions(QHash<QString, int>& actionIds, QStringList& actions) const {
+    // Ошибку чтения архива сообщит toCbor, который обходит историю следом
+    forEachHistoryEntry([&actionIds, &actions](const TaskHistoryEntry& entry) {
+        QString action = entry.getAction();
+        if (!actionIds.contains(action)) {
+            actionIds.insert(action, actions.size());
+            actions.append(action);
+        }
+    });
+}
+
+bool Task::toCbor(QCborStreamWriter& writer, const QHash<QString, int>& actionIds) const {
+    writer.startArray(7);
+    writer.append(id);
+    writer.append(title);
+    writer.append(description);
+    writer.append(static_cast<int>(status)); // Статус числом, а не строкой
+    writer.append(assignedDeveloperId);
+    Cbor::writeTimestamp(writer, deadline);
+
+    writer.startArray(); // Без длины: запись не зависит от чтения архива
+    bool complete = forEachHistoryEntry([&writer, &actionIds](const TaskHistoryEntry& entry) {
+        entry.toCbor(writer, actionIds);
+    });
+    writer.endArray();
+
+    writer.endArray();
+    return complete;
+}
+
+Task Task::fromCbor(QCborStreamReader& reader, const QStringList& actions) {
+    Task task;
+    if (!reader.isArray()) {
+        reader.next();
+        return task;
+    }
+
+    reader.enterContainer();
+    task.id = Cbor::readInteger(reader);
+    task.title = Cbor::readString(reader);
+    task.description = Cbor::readString(reader);
+    int status = int(Cbor::readInteger(reader));
+    task.status = status >= 0 && status <= static_cast<int>(TaskStatus::Done)
+        ? static_cast<TaskStatus>(status) : TaskStatus::Backlog;
+    task.assignedDeveloperId = Cbor::readInteger(reader, -1);
+    task.deadline = Cbor::readTimestamp(reader);
+
+    if (reader.isArray()) {
+        reader.enterContainer();
+        while (reader.hasNext() && reader.lastError() == QCborError::NoError) {
+            task.history.append(TaskHistoryEntry::fromCbor(reader, actions));
+        }
+        reader.leaveContainer();
+    } else if (reader.hasNext()) {
+        reader.next();
+    }
+    Cbor::leave(reader); // Поля из более новых версий формата
+    return task;
+}
+
 QString Task::statusToString(TaskStatus status) { //TaskStatus (enum class) автоматически конвертируется в int
     switch (status) { //switch - работает только с целыми типами (int, char, enum)
     case TaskStatus::Backlog:    return "Backlog";
@@ -149,19 +461,238 @@ TaskStatus Task::stringToStatus(const QString& str) { //QString (объект с
     return TaskStatus::Backlog;
 }
 
+// ========== ЗАПИСЬ ИСТОРИИ ==========
+
+TaskHistoryEntry::TaskHistoryEntry(const QDateTime& timestamp, const QString& action, const QString& details)
+    : time(timestamp.isValid() ? timestamp.toMSecsSinceEpoch() : InvalidTime) {
+    if (!recognize(action, details)) {
+        *this = TaskHistoryEntry();
+        time = timestamp.isValid() ? timestamp.toMSecsSinceEpoch() : InvalidTime;
+        actionId = internAction(action);
+        text = details;
+    }
+}
+
+TaskHistoryEntry TaskHistoryEntry::now(HistoryEvent event) {
+    TaskHistoryEntry entry;
+    entry.time = QDateTime::currentMSecsSinceEpoch();
+    entry.event = event;
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::created(const QString& title) {
+    TaskHistoryEntry entry = now(HistoryEvent::Created);
+    entry.text = title; // Данные строки общие с названием задачи
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::titleChanged(const QString& oldTitle, const QString& newTitle) {
+    TaskHistoryEntry entry = now(HistoryEvent::TitleChanged);
+    entry.text = oldTitle + newTitle;
+    entry.oldValue = oldTitle.size();
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::descriptionChanged() {
+    return now(HistoryEvent::DescriptionChanged);
+}
+
+TaskHistoryEntry TaskHistoryEntry::statusChanged(TaskStatus oldStatus, TaskStatus newStatus) {
+    TaskHistoryEntry entry = now(HistoryEvent::StatusChanged);
+    entry.oldValue = static_cast<int>(oldStatus);
+    entry.newValue = static_cast<int>(newStatus);
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::assigned(DeveloperId developerId) {
+    TaskHistoryEntry entry = now(HistoryEvent::Assigned);
+    entry.newValue = developerId;
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::unassigned() {
+    return now(HistoryEvent::Unassigned);
+}
+
+TaskHistoryEntry TaskHistoryEntry::deadlineChanged(const QDateTime& newDeadline) {
+    TaskHistoryEntry entry = now(HistoryEvent::DeadlineChanged);
+    entry.newValue = newDeadline.isValid() ? newDeadline.toMSecsSinceEpoch() : InvalidTime;
+    return entry;
+}
+
+QDateTime TaskHistoryEntry::getTimestamp() const {
+    return time == InvalidTime ? QDateTime() : QDateTime::fromMSecsSinceEpoch(time);
+}
+
+QString TaskHistoryEntry::getAction() const {
+    return event == HistoryEvent::Custom ? internedAction(actionId) : eventAction(event);
+}
+
+QString TaskHistoryEntry::getDetails() const {
+    switch (event) {
+    case HistoryEvent::Created:
+        return QString("Задача '%1' создана").arg(text);
+    case HistoryEvent::TitleChanged:
+        return "'" + text.left(int(oldValue)) + TitleArrow + text.mid(int(oldValue)) + "'";
+    case HistoryEvent::DescriptionChanged:
+        return QStringLiteral("Описание обновлено");
+    case HistoryEvent::StatusChanged:
+        return Task::statusToString(static_cast<TaskStatus>(oldValue)) + StatusArrow
+             + Task::statusToString(static_cast<TaskStatus>(newValue));
+    case HistoryEvent::Assigned:
+        return AssignedPrefix + QString::number(newValue);
+    case HistoryEvent::Unassigned:
+        return QStringLiteral("Разработчик снят с задачи");
+    case HistoryEvent::DeadlineChanged:
+        return newValue == InvalidTime
+            ? QStringLiteral("Дедлайн удален")
+            : DeadlinePrefix + QDateTime::fromMSecsSinceEpoch(newValue).toString(DeadlineFormat);
+    default:
+        return text;
+    }
+}
+
+// Значения восстанавливаются из текста; событие принимается, только если из него
+// собирается ровно тот же текст (иначе запись остается Custom и ничего не теряет)
+bool TaskHistoryEntry::recognize(const QString& action, const QString& details) {
+    HistoryEvent kind = HistoryEvent::Custom;
+    for (int i = static_cast<int>(HistoryEvent::Created); i <= static_cast<int>(HistoryEvent::DeadlineChanged); i++) {
+        if (action == eventAction(static_cast<HistoryEvent>(i))) {
+            kind = static_cast<HistoryEvent>(i);
+            break;
+        }
+    }
+
+    switch (kind) {
+    case HistoryEvent::Created: {
+        QString prefix = QStringLiteral("Задача '");
+        QString suffix = QStringLiteral("' создана");
+        if (!details.startsWith(prefix) || !details.endsWith(suffix)
+            || details.size() < prefix.size() + suffix.size()) {
+            return false;
+        }
+        text = details.mid(prefix.size(), details.size() - prefix.size() - suffix.size());
+        break;
+    }
+    case HistoryEvent::TitleChanged: {
+        int arrow = details.indexOf(TitleArrow);
+        if (arrow < 1 || !details.startsWith('\'') || !details.endsWith('\'')
+            || details.size() < arrow + TitleArrow.size() + 1) {
+            return false;
+        }
+        QString oldTitle = details.mid(1, arrow - 1);
+        text = oldTitle + details.mid(arrow + TitleArrow.size(), details.size() - arrow - TitleArrow.size() - 1);
+        oldValue = oldTitle.size();
+        break;
+    }
+    case HistoryEvent::StatusChanged: {
+        int arrow = details.indexOf(StatusArrow);
+        if (arrow < 0) {
+            return false;
+        }
+        oldValue = static_cast<int>(Task::stringToStatus(details.left(arrow)));
+        newValue = static_cast<int>(Task::stringToStatus(details.mid(arrow + StatusArrow.size())));
+        break;
+    }
+    case HistoryEvent::Assigned: {
+        bool ok = false;
+        newValue = details.startsWith(AssignedPrefix) ? details.mid(AssignedPrefix.size()).toLongLong(&ok) : 0;
+        if (!ok) {
+            return false;
+        }
+        break;
+    }
+    case HistoryEvent::DeadlineChanged:
+        if (details.startsWith(DeadlinePrefix)) {
+            QDate date = QDate::fromString(details.mid(DeadlinePrefix.size()), DeadlineFormat);
+            if (!date.isValid()) {
+                return false;
+            }
+            newValue = QDateTime(date, QTime(0, 0)).toMSecsSinceEpoch();
+        } else {
+            newValue = InvalidTime; // "Дедлайн удален" - проверит сравнение ниже
+        }
+        break;
+    case HistoryEvent::DescriptionChanged:
+    case HistoryEvent::Unassigned:
+        break; // Детали постоянные
+    default:
+        return false;
+    }
+
+    event = kind;
+    return getDetails() == details;
+}
+
 // Сериализация объекта TaskHistoryEntry в формат JSON
 QJsonObject TaskHistoryEntry::toJson() const {
     QJsonObject json; // Создаем пустой JSON-объект
-    json["timestamp"] = timestamp.toString(Qt::ISODate);
-    json["action"] = action;
-    json["details"] = details;
+    json["timestamp"] = getTimestamp().toString(Qt::ISODate);
+    json["action"] = getAction();
+    json["details"] = getDetails();
     return json; // Возвращаем заполненный JSON-объект
 }
 // Десериализация JSON-объекта обратно в объект TaskHistoryEntry
 TaskHistoryEntry TaskHistoryEntry::fromJson(const QJsonObject& json) {
-    TaskHistoryEntry entry; // Создаем новый объект записи истории
-    entry.timestamp = QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate); //Все поля сохраняются как строки
-    entry.action = json["action"].toString(); 
-    entry.details = json["details"].toString();
-    return entry; // Возвращаем восстановленный объект записи истории
-}
\ No newline at end of file
+    return TaskHistoryEntry(QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate), //Все поля сохраняются как строки
+                            json["action"].toString(),
+                            json["details"].toString());
+}
+
+void TaskHistoryEntry::toJsonStream(JsonStreamWriter& writer) const {
+    writer.startObject();
+    writer.writeMember("action", getAction());
+    writer.writeMember("details", getDetails());
+    writer.writeMember("timestamp", getTimestamp().toString(Qt::ISODate));
+    writer.endObject();
+}
+
+TaskHistoryEntry TaskHistoryEntry::fromJsonStream(JsonStreamReader& reader) {
+    if (!reader.enterObject()) {
+        reader.skipValue();
+        return TaskHistoryEntry();
+    }
+
+    QDateTime timestamp;
+    QString action;
+    QString details;
+    QString key;
+    while (reader.nextKey(key)) {
+        if (key == QLatin1String("timestamp")) {
+            timestamp = QDateTime::fromString(reader.toString(), Qt::ISODate);
+        } else if (key == QLatin1String("action")) {
+            action = reader.toString();
+        } else if (key == QLatin1String("details")) {
+            details = reader.toString();
+        } else {
+            reader.skipValue();
+        }
+    }
+    return TaskHistoryEntry(timestamp, action, details);
+}
+
+void TaskHistoryEntry::toCbor(QCborStreamWriter& writer, const QHash<QString, int>& actionIds) const {
+    writer.startArray(3);
+    if (time == InvalidTime) {
+        writer.appendNull();
+    } else {
+        writer.append(time);
+    }
+    writer.append(actionIds.value(getAction()));
+    writer.append(getDetails());
+    writer.endArray();
+}
+
+TaskHistoryEntry TaskHistoryEntry::fromCbor(QCborStreamReader& reader, const QStringList& actions) {
+    if (!reader.isArray()) {
+        reader.next();
+        return TaskHistoryEntry();
+    }
+
+    reader.enterContainer();
+    QDateTime timestamp = Cbor::readTimestamp(reader);
+    QString action = actions.value(int(Cbor::readInteger(reader, -1))); // Неизвестный номер - пустая строка
+    QString details = Cbor::readString(reader);
+    Cbor::leave(reader);
+    return TaskHistoryEntry(timestamp, action, details);
+}
@@ -3,8 +3,22 @@
 
 #include <QString>
 #include <QJsonObject>
+#include <QJsonArray>
 #include <QDateTime>
 #include <QList>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+#include <limits>
+#include <memory>
+#include "entityid.h"
+#include "historyarchive.h"
+
+class QCborStreamWriter;
+class QCborStreamReader;
+class JsonStreamReader;
+class JsonStreamWriter;
 
 // Статусы задачи
 enum class TaskStatus {
@@ -15,14 +29,99 @@ enum class TaskStatus {
     Done        // СДЕЛАНО!
 };
 
-// Запись в истории задачи
-struct TaskHistoryEntry {
-    QDateTime timestamp;
-    QString action;
-    QString details;
+// Вид события истории. Текст известных событий собирается из значений при показе
+enum class HistoryEvent : quint8 {
+    Custom,             // Произвольная запись: действие из общей таблицы, детали - текстом
+    Created,
+    TitleChanged,
+    DescriptionChanged,
+    StatusChanged,
+    Assigned,
+    Unassigned,
+    DeadlineChanged
+};
+
+// Запись в истории задачи: компактное событие (вид, время в мс, старое и новое значение)
+// без готовых строк. Действие и детали собираются лениво - для показа и записи в файл -
+// и совпадают с прежним текстом, поэтому форматы файлов не меняются
+class TaskHistoryEntry {
+public:
+    TaskHistoryEntry() = default;
+    // Запись из текста (файл, журнал, addHistoryEntry): известные действия распознаются
+    // в событие, если из него собирается тот же текст, остальные хранятся как Custom
+    TaskHistoryEntry(const QDateTime& timestamp, const QString& action, const QString& details);
+
+    // События сеттеров задачи с текущим временем
+    static TaskHistoryEntry created(const QString& title);
+    static TaskHistoryEntry titleChanged(const QString& oldTitle, const QString& newTitle);
+    static TaskHistoryEntry descriptionChanged();
+    static TaskHistoryEntry statusChanged(TaskStatus oldStatus, TaskStatus newStatus);
+    static TaskHistoryEntry assigned(DeveloperId developerId);
+    static TaskHistoryEntry unassigned();
+    static TaskHistoryEntry deadlineChanged(const QDateTime& newDeadline);
+
+    HistoryEvent getEvent() const { return event; }
+    QDateTime getTimestamp() const;
+    qint64 getTimestampMs() const { return time; } // InvalidTime - без времени
+    qint64 getOldValue() const { return oldValue; } // Статус (StatusChanged)
+    qint64 getNewValue() const { return newValue; } // Статус, ID разработчика, дедлайн в мс
+    QString getAction() const;  // Текст действия: для известных событий - без выделения памяти
+    QString getDetails() const; // Собирается при каждом вызове
+
+    static constexpr qint64 InvalidTime = std::numeric_limits<qint64>::min();
 
     QJsonObject toJson() const;
     static TaskHistoryEntry fromJson(const QJsonObject& json);
+    void toJsonStream(JsonStreamWriter& writer) const;
+    static TaskHistoryEntry fromJsonStream(JsonStreamReader& reader);
+
+    // Бинарный формат: [время в мс, номер действия в таблице строк, детали]
+    void toCbor(QCborStreamWriter& writer, const QHash<QString, int>& actionIds) const;
+    static TaskHistoryEntry fromCbor(QCborStreamReader& reader, const QStringList& actions);
+
+private:
+    qint64 time = InvalidTime;
+    qint64 oldValue = 0;
+    qint64 newValue = 0;
+    // Created - название; TitleChanged - старое и новое название подряд (длина старого - в oldValue);
+    // Custom - детали. У остальных событий пусто и не занимает памяти
+    QString text;
+    quint32 actionId = 0; // Custom: номер действия в общей таблице (одна строка на все записи)
+    HistoryEvent event = HistoryEvent::Custom;
+
+    static TaskHistoryEntry now(HistoryEvent event);
+    bool recognize(const QString& action, const QString& details); // Разбор текста известного события
+};
+
+class Task;
+
+// Поле задачи, измененное сеттером
+enum class TaskField {
+    Title,
+    Description,
+    Status,
+    Assignee, // assignToDeveloper и unassign
+    Deadline
+};
+
+// Наблюдатель за изменениями задачи: через него доска-владелец поддерживает свои индексы
+class TaskObserver {
+public:
+    virtual ~TaskObserver() = default;
+    virtual void taskStatusChanged(Task* task, TaskStatus oldStatus) = 0;
+    virtual void taskAssigneeChanged(Task* task, DeveloperId oldDeveloperId) = 0;
+    // После любого сеттера, изменившего поле (последняя запись истории - от этого изменения)
+    virtual void taskEdited(Task* task, TaskField field) = 0;
+};
+
+// Связь задачи с доской. Не копируется вместе с задачей: копия доске не принадлежит
+struct TaskBoardLink {
+    TaskObserver* observer = nullptr;
+    quint64 sequence = 0; // Порядковый номер задачи на доске
+
+    TaskBoardLink() = default;
+    TaskBoardLink(const TaskBoardLink&) {}
+    TaskBoardLink& operator=(const TaskBoardLink&) { return *this; }
 };
 
 class Task {
@@ -30,20 +129,28 @@ public:
     Task();
     Task(const QString& title, const QString& description = "");
 
-    // Геттеры
-    int getId() const { return id; }
-    QString getTitle() const { return title; }
-    QString getDescription() const { return description; }
+    // Геттеры (строки и дату - по ссылке, без копии; ссылка живет, пока задачу не изменят)
+    TaskId getId() const { return id; } // 0 до добавления на доску
+    const QString& getTitle() const { return title; }
+    const QString& getDescription() const { return description; }
     TaskStatus getStatus() const { return status; }
-    int getAssignedDeveloperId() const { return assignedDeveloperId; }
-    QDateTime getDeadline() const { return deadline; }
-    QList<TaskHistoryEntry> getHistory() const { return history; }
+    DeveloperId getAssignedDeveloperId() const { return assignedDeveloperId; }
+    const QDateTime& getDeadline() const { return deadline; }
+    // История: последние записи в памяти, более старые - в архиве (limitHistory)
+    // Вся история; архивная часть читается с диска. *ok = false - архив не прочитан, список неполон
+    QList<TaskHistoryEntry> getHistory(bool* ok = nullptr) const;
+    const QList<TaskHistoryEntry>& getRecentHistory() const { return history; } // Только окно в памяти
+    int getHistorySize() const { return loadedHistoryCount + archivedCount + history.size(); }
+    // Вся история по порядку, архив - по блоку за раз: память не растет с длиной истории.
+    // false - блок архива не прочитан: обход прерван, история неполна
+    bool forEachHistoryEntry(const std::function<void(const TaskHistoryEntry&)>& visit) const;
+    quint64 getRevision() const { return revision; } // Растет при каждом изменении полей задачи
 
     // Сеттеры
     void setTitle(const QString& newTitle); // Изменить заголовок
     void setDescription(const QString& newDescription);
     void setStatus(TaskStatus newStatus);
-    void assignToDeveloper(int developerId); // Назначить разработчику
+    void assignToDeveloper(DeveloperId developerId); // Назначить разработчику
     void unassign(); // Снять назначение
     void setDeadline(const QDateTime& newDeadline);
 
@@ -52,27 +159,66 @@ public:
     bool hasDeadline() const { return deadline.isValid(); }
     int daysUntilDeadline() const;
     bool isOverdue() const; // Просрочена ли задача?
+    // То же относительно заданного момента: при обходе многих задач время берется один раз
+    int daysUntilDeadline(const QDateTime& now) const;
+    bool isOverdue(const QDateTime& now) const;
+
+    // Связь с доской (вызывается только доской при добавлении/удалении задачи)
+    void attachToBoard(TaskObserver* observer, quint64 sequence);
+    void assignId(TaskId newId) { id = newId; } // Задаче без ID доска выдает свой
+    void detachFromBoard() { boardLink = TaskBoardLink(); }
+    quint64 boardSequence() const { return boardLink.sequence; }
 
     // История
     void addHistoryEntry(const QString& action, const QString& details); // Добавить запись в историю
+    // Окно истории в памяти: сверх limit записей старшие уходят блоками в archive (0 - без ограничения).
+    // Задача, уже пишущая в архив, продолжает писать в свой
+    void limitHistory(int limit, const std::shared_ptr<HistoryArchive>& archive);
+    // Для воспроизведения журнала: время и текст записи - как при исходном изменении
+    void replaceLastHistoryEntry(const TaskHistoryEntry& entry);
 
-    // Сериализация
-    QJsonObject toJson() const; // Конвертировать задачу в JSON
+    // Сериализация. Запись истории читает архив: false (*ok = false) - архив не прочитан и
+    // записанная задача неполна, такой файл сохранять нельзя
+    QJsonObject toJson(bool* ok = nullptr) const; // Конвертировать задачу в JSON
     static Task fromJson(const QJsonObject& json);// Создать задачу из JSON
+    bool toJsonStream(JsonStreamWriter& writer) const; // Потоковая запись (текст как у toJson)
+    static Task fromJsonStream(JsonStreamReader& reader); // Из потокового JSON (результат как у fromJson)
+
+    // Бинарный формат (CBOR): массив полей, действия истории - номера в общей таблице строк
+    void collectHistoryActions(QHash<QString, int>& actionIds, QStringList& actions) const; // Пополнить таблицу
+    bool toCbor(QCborStreamWriter& writer, const QHash<QString, int>& actionIds) const;
+    static Task fromCbor(QCborStreamReader& reader, const QStringList& actions);
 
     // Конвертация статуса в строку и обратно
     static QString statusToString(TaskStatus status);
     static TaskStatus stringToStatus(const QString& str);
 
 private:
-    static int nextId;
-    int id;
+    TaskId id = 0;
     QString title;
     QString description;
     TaskStatus status;
-    int assignedDeveloperId; // -1 если не назначена
+    DeveloperId assignedDeveloperId; // -1 если не назначена
     QDateTime deadline;
-    QList<TaskHistoryEntry> history;
+    QList<TaskHistoryEntry> history; // Последние записи; более старые - в historyArchive
+    // История из JSON, не разобранная при загрузке: самые старые записи, раньше архива и окна.
+    // В окно и его лимит не входит. Текст массива (fromJsonStream) или QJsonArray (fromJson)
+    // разбирается заново при каждом обходе, а в JSON сохраняется без разбора
+    QByteArray loadedHistoryText;
+    QJsonArray loadedHistoryArray;
+    int loadedHistoryCount = 0;
+    std::shared_ptr<HistoryArchive> historyArchive; // Общий у копий задачи: блоки архива не меняются
+    QVector<HistoryArchive::Block> archivedBlocks;
+    int archivedCount = 0;
+    int historyLimit = 0;
+    quint64 revision = 0;
+    TaskBoardLink boardLink;
+
+    void appendHistory(const TaskHistoryEntry& entry); // Запись от сеттера: растет и ревизия
+    void spillHistory(); // Старшие записи окна - в архив
+    void forEachLoadedEntry(const std::function<void(const TaskHistoryEntry&)>& visit) const;
+    bool forEachStoredEntry(const std::function<void(const TaskHistoryEntry&)>& visit) const; // Архив и окно
+    void notifyEdited(TaskField field);
 };
 
 #endif // TASK_H
\ No newline at end of file
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h> // Подключаем библиотеку Google Test
 #include "../models/board.h"
+#include "../models/boardbinary.h"
+#include "../models/boardsaver.h"
 #include <QFile> // Для работы с файлами
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QSet>
+#include <atomic>
 
 // Класс BoardTest наследуется от testing::Test
 class BoardTest : public ::testing::Test {
@@ -9,6 +16,7 @@ protected:
 
     void TearDown() override { //Для очистки
         QFile::remove("test_board.json");
+        QFile::remove("test_board.sbb");
     }
 };
 
@@ -39,6 +47,32 @@ TEST_F(BoardTest, AddTask) {
     EXPECT_EQ(board.getTasks()[0].getTitle(), "Тестовая задача");
 }
 
+TEST_F(BoardTest, DuplicateIdGetsFreshId) {
+    // Как при загрузке файла, где две задачи и два разработчика записаны с одним ID
+    Task task("Первая");
+    task.assignId(5);
+    Task* first = board.addTask(task);
+    task = Task("Вторая");
+    task.assignId(5);
+    Task* second = board.addTask(task);
+
+    EXPECT_EQ(first->getId(), 5);
+    EXPECT_NE(second->getId(), 5);
+    EXPECT_EQ(board.getTask(5), first);
+    EXPECT_EQ(board.getTask(second->getId()), second);
+    EXPECT_TRUE(board.removeTask(second->getId())); // Дубликат достижим и удаляется
+    EXPECT_EQ(board.getTasks().size(), 1);
+    EXPECT_EQ(board.countByStatus(TaskStatus::Backlog), 1);
+
+    Developer dev("Иван");
+    dev.assignId(3);
+    Developer* firstDev = board.addDeveloper(dev);
+    Developer* secondDev = board.addDeveloper(dev);
+    EXPECT_EQ(board.getDeveloper(3), firstDev);
+    EXPECT_NE(secondDev->getId(), 3);
+    EXPECT_EQ(board.getDeveloper(secondDev->getId()), secondDev);
+}
+
 TEST_F(BoardTest, RemoveTask) {
     Task task("Задача");
     board.addTask(task);
@@ -344,4 +378,771 @@ TEST_F(BoardTest, SaveAndLoadWithDeadlines) {
     EXPECT_TRUE(foundTaskWithDeadline);
 
     QFile::remove("test_board_deadline.json");
-}
\ No newline at end of file
+}
+// ========== ТЕСТЫ ИНДЕКСА ПО ID ==========
+
+TEST_F(BoardTest, TaskIndexAfterRemoveFromMiddle) {
+    QList<TaskId> ids;
+    for (int i = 0; i < 5; i++) {
+        ids.append(board.addTask(Task(QString("Задача %1").arg(i)))->getId()); // ID выдает доска
+    }
+
+    EXPECT_TRUE(board.removeTask(ids[2])); // Удаляем из середины - хвост сдвигается
+    EXPECT_EQ(board.getTask(ids[2]), nullptr);
+
+    // Все оставшиеся задачи находятся по ID и указывают на правильные элементы
+    for (int i : {0, 1, 3, 4}) {
+        Task* found = board.getTask(ids[i]);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->getId(), ids[i]);
+        EXPECT_EQ(found->getTitle(), QString("Задача %1").arg(i));
+    }
+
+    // Повторное удаление того же ID ничего не ломает
+    EXPECT_FALSE(board.removeTask(ids[2]));
+    EXPECT_TRUE(board.removeTask(ids[4]));
+    EXPECT_EQ(board.getTask(ids[3])->getTitle(), "Задача 3");
+}
+
+TEST_F(BoardTest, DeveloperIndexAfterRemove) {
+    DeveloperId id1 = board.addDeveloper(Developer("Первый", "Dev"))->getId();
+    DeveloperId id2 = board.addDeveloper(Developer("Второй", "Dev"))->getId();
+    DeveloperId id3 = board.addDeveloper(Developer("Третий", "Dev"))->getId();
+
+    EXPECT_TRUE(board.removeDeveloper(id1));
+    EXPECT_EQ(board.getDeveloper(id1), nullptr);
+
+    ASSERT_NE(board.getDeveloper(id2), nullptr);
+    EXPECT_EQ(board.getDeveloper(id2)->getName(), "Второй");
+    ASSERT_NE(board.getDeveloper(id3), nullptr);
+    EXPECT_EQ(board.getDeveloper(id3)->getName(), "Третий");
+}
+
+TEST_F(BoardTest, IndexClearedByClear) {
+    TaskId taskId = board.addTask(Task("Задача"))->getId();
+    DeveloperId devId = board.addDeveloper(Developer("Разработчик", "Dev"))->getId();
+
+    board.clear();
+
+    EXPECT_EQ(board.getTask(taskId), nullptr);
+    EXPECT_EQ(board.getDeveloper(devId), nullptr);
+    EXPECT_FALSE(board.removeTask(taskId));
+}
+
+TEST_F(BoardTest, IndexRebuiltAfterLoad) {
+    DeveloperId devId = board.addDeveloper(Developer("Иван", "Dev"))->getId();
+    TaskId task1Id = board.addTask(Task("Первая"))->getId();
+    TaskId task2Id = board.addTask(Task("Вторая"))->getId();
+
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+
+    Board newBoard;
+    newBoard.addTask(Task("Будет удалена при загрузке"));
+    EXPECT_TRUE(newBoard.loadFromFile("test_board.json"));
+
+    ASSERT_NE(newBoard.getTask(task2Id), nullptr);
+    EXPECT_EQ(newBoard.getTask(task2Id)->getTitle(), "Вторая");
+    ASSERT_NE(newBoard.getDeveloper(devId), nullptr);
+    EXPECT_EQ(newBoard.getDeveloper(devId)->getName(), "Иван");
+
+    EXPECT_TRUE(newBoard.removeTask(task1Id));
+    EXPECT_EQ(newBoard.getTask(task2Id)->getTitle(), "Вторая");
+}
+
+// ========== ТЕСТЫ СТАБИЛЬНОГО ХРАНИЛИЩА ==========
+
+TEST_F(BoardTest, TaskPointerSurvivesInsertions) {
+    Task* first = board.addTask(Task("Первая"));
+    int firstId = first->getId();
+
+    for (int i = 0; i < 5000; i++) { // Достаточно, чтобы обычный список перевыделил память
+        board.addTask(Task(QString("Задача %1").arg(i)));
+    }
+
+    EXPECT_EQ(board.getTask(firstId), first); // Адрес не изменился
+    EXPECT_EQ(first->getTitle(), "Первая");
+}
+
+TEST_F(BoardTest, TaskPointerSurvivesRemovals) {
+    Task* a = board.addTask(Task("A"));
+    Task* b = board.addTask(Task("B"));
+    Task* c = board.addTask(Task("C"));
+
+    EXPECT_TRUE(board.removeTask(a->getId()));
+    EXPECT_TRUE(board.removeTask(b->getId()));
+
+    EXPECT_EQ(board.getTask(c->getId()), c);
+    EXPECT_EQ(c->getTitle(), "C");
+    EXPECT_EQ(board.getTasks().size(), 1);
+    EXPECT_EQ(board.getTasks()[0].getTitle(), "C");
+}
+
+TEST_F(BoardTest, StaleHandleAfterRemove) {
+    Task* task = board.addTask(Task("Задача"));
+    int taskId = task->getId();
+    TaskHandle handle = board.getTaskHandle(taskId);
+
+    EXPECT_EQ(board.resolveTask(handle), task);
+
+    board.removeTask(taskId);
+    EXPECT_EQ(board.resolveTask(handle), nullptr);
+
+    // Новая задача может занять тот же слот, но старый дескриптор остается невалидным
+    Task* reused = board.addTask(Task("Новая"));
+    EXPECT_EQ(board.resolveTask(handle), nullptr);
+    EXPECT_EQ(board.resolveTask(board.getTaskHandle(reused->getId())), reused);
+}
+
+TEST_F(BoardTest, InsertionOrderKeptAfterManyRemovals) {
+    QList<int> ids;
+    for (int i = 0; i < 200; i++) {
+        ids.append(board.addTask(Task(QString::number(i)))->getId());
+    }
+    for (int i = 0; i < 200; i += 2) { // Удаляем каждую вторую - в порядке остаются надгробия
+        EXPECT_TRUE(board.removeTask(ids[i]));
+    }
+
+    EXPECT_EQ(board.getTasks().size(), 100);
+    int expected = 1;
+    for (const Task& task : board.getTasks()) {
+        EXPECT_EQ(task.getTitle(), QString::number(expected));
+        expected += 2;
+    }
+    EXPECT_EQ(board.getTasks()[99].getTitle(), "199");
+}
+
+TEST_F(BoardTest, RemoveWhileIterating) {
+    for (int i = 0; i < 300; i++) {
+        board.addTask(Task(QString::number(i)));
+    }
+
+    // Удаляем две задачи из трех прямо в обходе: надгробий становится больше, чем живых,
+    // но порядок не уплотняется, пока обход идет, - каждая задача посещается ровно один раз
+    QList<TaskId> visited;
+    for (Task& task : board.getTasks()) {
+        TaskId taskId = task.getId();
+        visited.append(taskId);
+        if (taskId % 3 != 0) {
+            ASSERT_TRUE(board.removeTask(taskId));
+        }
+        if (taskId % 3 == 1 && taskId + 1 <= 300) {
+            ASSERT_TRUE(board.removeTask(taskId + 1)); // Еще не посещенная задача пропускается
+        }
+    }
+    EXPECT_EQ(visited.size(), 200);
+    for (int i = 1; i < visited.size(); i++) {
+        EXPECT_LT(visited[i - 1], visited[i]);
+    }
+
+    // Доступ по позиции с надгробиями и после уплотнения (begin) дает одинаковый результат
+    ASSERT_EQ(board.getTasks().size(), 100);
+    EXPECT_EQ(board.getTasks()[0].getId(), 3);
+    EXPECT_EQ(board.getTasks()[99].getId(), 300);
+    int position = 0;
+    for (const Task& task : board.getTasks()) {
+        EXPECT_EQ(board.getTasks()[position++].getId(), task.getId());
+    }
+}
+
+TEST_F(BoardTest, DeveloperPointerSurvivesRemovals) {
+    Developer* first = board.addDeveloper(Developer("Первый", "Dev"));
+    Developer* second = board.addDeveloper(Developer("Второй", "Dev"));
+
+    EXPECT_TRUE(board.removeDeveloper(first->getId()));
+    EXPECT_EQ(board.getDeveloper(second->getId()), second);
+    EXPECT_EQ(board.resolveDeveloper(board.getDeveloperHandle(second->getId())), second);
+}
+
+// ========== ТЕСТЫ ИНДЕКСА СТАТУСОВ ==========
+
+TEST_F(BoardTest, StatusIndexFollowsSetStatus) {
+    Task* a = board.addTask(Task("A"));
+    Task* b = board.addTask(Task("B"));
+
+    EXPECT_EQ(board.countByStatus(TaskStatus::Backlog), 2);
+
+    b->setStatus(TaskStatus::Review); // Изменение через указатель на задачу доски
+    EXPECT_EQ(board.countByStatus(TaskStatus::Backlog), 1);
+    EXPECT_EQ(board.countByStatus(TaskStatus::Review), 1);
+    EXPECT_EQ(board.tasksWithStatus(TaskStatus::Review).first(), b);
+
+    board.getTasks()[0].setStatus(TaskStatus::Review);
+    EXPECT_EQ(board.countByStatus(TaskStatus::Backlog), 0);
+    EXPECT_EQ(board.countByStatus(TaskStatus::Review), 2);
+
+    // Порядок внутри статуса совпадает с порядком доски, а не порядком смены статуса
+    QList<Task*> review = board.tasksWithStatus(TaskStatus::Review).values();
+    ASSERT_EQ(review.size(), 2);
+    EXPECT_EQ(review[0], a);
+    EXPECT_EQ(review[1], b);
+}
+
+TEST_F(BoardTest, StatusViewIsLiveIndex) {
+    // tasksWithStatus отдает сам индекс: одна и та же ссылка видит все изменения доски
+    const TaskSet& review = board.tasksWithStatus(TaskStatus::Review);
+    EXPECT_EQ(&review, &board.tasksWithStatus(TaskStatus::Review));
+    EXPECT_TRUE(review.isEmpty());
+
+    Task* task = board.addTask(Task("A"));
+    task->setStatus(TaskStatus::Review);
+    ASSERT_EQ(review.size(), 1);
+    EXPECT_EQ(review.first(), task);
+
+    board.removeTask(task->getId());
+    EXPECT_TRUE(review.isEmpty());
+}
+
+TEST_F(BoardTest, StatusIndexUpdatedOnRemove) {
+    Task task("Задача");
+    task.setStatus(TaskStatus::InProgress);
+    int taskId = board.addTask(task)->getId();
+
+    EXPECT_EQ(board.countByStatus(TaskStatus::InProgress), 1);
+    board.removeTask(taskId);
+    EXPECT_EQ(board.countByStatus(TaskStatus::InProgress), 0);
+    EXPECT_TRUE(board.tasksWithStatus(TaskStatus::InProgress).isEmpty());
+}
+
+TEST_F(BoardTest, CopiedTaskDoesNotTouchIndex) {
+    Task* stored = board.addTask(Task("Задача"));
+
+    Task copy = *stored; // Копия не принадлежит доске
+    copy.setStatus(TaskStatus::Done);
+
+    EXPECT_EQ(board.countByStatus(TaskStatus::Done), 0);
+    EXPECT_EQ(board.countByStatus(TaskStatus::Backlog), 1);
+}
+
+TEST_F(BoardTest, StatusIndexAfterLoadAndClear) {
+    Task task("Задача");
+    task.setStatus(TaskStatus::Assigned);
+    board.addTask(task);
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+
+    Board newBoard;
+    EXPECT_TRUE(newBoard.loadFromFile("test_board.json"));
+    EXPECT_EQ(newBoard.countByStatus(TaskStatus::Assigned), 1);
+
+    newBoard.clear();
+    EXPECT_EQ(newBoard.countByStatus(TaskStatus::Assigned), 0);
+}
+
+// ========== ТЕСТЫ ИНДЕКСА РАЗРАБОТЧИКОВ ==========
+
+TEST_F(BoardTest, DeveloperIndexFollowsAssignments) {
+    Developer* dev1 = board.addDeveloper(Developer("Первый", "Dev"));
+    Developer* dev2 = board.addDeveloper(Developer("Второй", "Dev"));
+
+    Task* a = board.addTask(Task("A"));
+    Task* b = board.addTask(Task("B"));
+
+    a->assignToDeveloper(dev1->getId());
+    b->assignToDeveloper(dev1->getId());
+    EXPECT_EQ(board.countByDeveloper(dev1->getId()), 2);
+
+    b->assignToDeveloper(dev2->getId()); // Переназначение переносит задачу между множествами
+    EXPECT_EQ(board.countByDeveloper(dev1->getId()), 1);
+    EXPECT_EQ(board.countByDeveloper(dev2->getId()), 1);
+    EXPECT_EQ(board.tasksOfDeveloper(dev2->getId()).first(), b);
+
+    a->unassign();
+    EXPECT_EQ(board.countByDeveloper(dev1->getId()), 0);
+    EXPECT_TRUE(board.tasksOfDeveloper(dev1->getId()).isEmpty());
+}
+
+TEST_F(BoardTest, DeveloperIndexOnTaskRemove) {
+    Task task("Задача");
+    task.assignToDeveloper(7); // Назначена до добавления на доску
+    int taskId = board.addTask(task)->getId();
+
+    EXPECT_EQ(board.countByDeveloper(7), 1);
+    board.removeTask(taskId);
+    EXPECT_EQ(board.countByDeveloper(7), 0);
+}
+
+TEST_F(BoardTest, RemoveDeveloperUnassignsOnlyHisTasks) {
+    Developer* dev1 = board.addDeveloper(Developer("Первый", "Dev"));
+    Developer* dev2 = board.addDeveloper(Developer("Второй", "Dev"));
+    int dev1Id = dev1->getId();
+    int dev2Id = dev2->getId();
+
+    Task* a = board.addTask(Task("A"));
+    Task* b = board.addTask(Task("B"));
+    Task* c = board.addTask(Task("C"));
+    a->assignToDeveloper(dev1Id);
+    b->assignToDeveloper(dev1Id);
+    c->assignToDeveloper(dev2Id);
+
+    EXPECT_TRUE(board.removeDeveloper(dev1Id));
+
+    EXPECT_FALSE(a->isAssigned());
+    EXPECT_FALSE(b->isAssigned());
+    EXPECT_EQ(c->getAssignedDeveloperId(), dev2Id);
+    EXPECT_EQ(board.countByDeveloper(dev1Id), 0);
+    EXPECT_EQ(board.countByDeveloper(dev2Id), 1);
+}
+
+// ========== ТЕСТЫ ПОТОКОВОЙ ЗАГРУЗКИ JSON ==========
+
+TEST_F(BoardTest, StreamingLoadRejectsDamagedJson) {
+    board.addTask(Task("Старая задача"));
+
+    const char* samples[] = {
+        R"([{"tasks": []}])",                       // Корень - не объект
+        R"({"tasks": [{"title": "A"}]} мусор)",     // Данные после документа
+        R"({"tasks": [{"title": "A"}, {"title": )"  // Файл обрезан
+    };
+    for (const char* sample : samples) {
+        QFile file("test_board.json");
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(sample);
+        file.close();
+
+        EXPECT_FALSE(board.loadFromFile("test_board.json")) << sample;
+        ASSERT_EQ(board.getTasks().size(), 1); // Доска не тронута
+        EXPECT_EQ(board.getTasks()[0].getTitle(), "Старая задача");
+    }
+}
+
+TEST_F(BoardTest, StreamingLoadHandlesKeyOrderAndBom) {
+    QFile file("test_board.json");
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    // Задачи раньше разработчиков, неизвестный ключ и метка порядка байт в начале
+    file.write("\xEF\xBB\xBF");
+    file.write(R"({"tasks": [{"id": 501, "title": "A", "status": "Review", "assignedDeveloperId": 301}],
+                  "meta": {"version": [1, 2]},
+                  "developers": [{"id": 301, "name": "Dev"}]})");
+    file.close();
+
+    ASSERT_TRUE(board.loadFromFile("test_board.json"));
+    ASSERT_EQ(board.getDevelopers().size(), 1);
+    ASSERT_EQ(board.getTasks().size(), 1);
+    EXPECT_EQ(board.getTasks()[0].getId(), 501);
+    EXPECT_EQ(board.countByStatus(TaskStatus::Review), 1);
+    EXPECT_EQ(board.countByDeveloper(301), 1);
+}
+
+TEST_F(BoardTest, CompactJsonSaveAndLoad) {
+    board.addDeveloper(Developer("Иван", "Developer"));
+    Task* task = board.addTask(Task("Задача"));
+    task->setStatus(TaskStatus::Done);
+
+    EXPECT_TRUE(board.saveToFile("test_board.json", Board::FileFormat::JsonCompact));
+    QFile file("test_board.json");
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    EXPECT_FALSE(file.readAll().contains('\n')); // Без отступов и переводов строк
+    file.close();
+
+    Board newBoard;
+    EXPECT_TRUE(newBoard.loadFromFile("test_board.json"));
+    EXPECT_EQ(newBoard.getDevelopers().size(), 1);
+    ASSERT_EQ(newBoard.getTasks().size(), 1);
+    EXPECT_EQ(newBoard.getTasks()[0].getStatus(), TaskStatus::Done);
+}
+
+// Замер: сохранение большой доски потоковой записью
+TEST_F(BoardTest, StreamingSaveTiming) {
+    for (int i = 0; i < 2000; i++) {
+        Task* task = board.addTask(Task(QString("Задача %1").arg(i), "Описание задачи"));
+        for (int j = 0; j < 10; j++) {
+            task->addHistoryEntry("Комментарий", QString("Запись %1").arg(j));
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+    qint64 indentedNs = timer.nsecsElapsed();
+    timer.restart();
+    EXPECT_TRUE(board.saveToFile("test_board.json", Board::FileFormat::JsonCompact));
+    qint64 compactNs = timer.nsecsElapsed();
+
+    Board newBoard;
+    EXPECT_TRUE(newBoard.loadFromFile("test_board.json"));
+    EXPECT_EQ(newBoard.getTasks().size(), 2000);
+
+    RecordProperty("indented_save_us", static_cast<int>(indentedNs / 1000));
+    RecordProperty("compact_save_us", static_cast<int>(compactNs / 1000));
+}
+
+// ========== ТЕСТЫ ВЫДАЧИ ID ==========
+
+TEST_F(BoardTest, IdsArePerBoardAndDense) {
+    Board other;
+    EXPECT_EQ(board.addTask(Task("A"))->getId(), 1);
+    EXPECT_EQ(board.addTask(Task("B"))->getId(), 2);
+    EXPECT_EQ(other.addTask(Task("C"))->getId(), 1); // У каждой доски свой счетчик
+    EXPECT_EQ(board.addDeveloper(Developer("Dev"))->getId(), 1);
+
+    Task temporary; // Временные объекты не расходуют ID
+    Task copy("Копия");
+    EXPECT_EQ(temporary.getId(), 0);
+    EXPECT_TRUE(temporary.getHistory().isEmpty());
+    EXPECT_EQ(board.addTask(copy)->getId(), 3);
+
+    board.clear();
+    EXPECT_EQ(board.addTask(Task("После очистки"))->getId(), 1);
+}
+
+TEST_F(BoardTest, LoadReservesIdsWithoutConsumingThem) {
+    board.addDeveloper(Developer("Dev"));
+    for (int i = 0; i < 3; i++) {
+        board.addTask(Task(QString::number(i)));
+    }
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+    EXPECT_TRUE(board.saveToFile("test_board.sbb", Board::FileFormat::Binary));
+
+    for (const char* file : {"test_board.json", "test_board.sbb"}) {
+        Board newBoard;
+        ASSERT_TRUE(newBoard.loadFromFile(file));
+        EXPECT_EQ(newBoard.addTask(Task("Новая"))->getId(), 4) << file; // Сразу за загруженными
+        EXPECT_EQ(newBoard.addDeveloper(Developer("Новый"))->getId(), 2) << file;
+    }
+}
+
+TEST_F(BoardTest, ConcurrentIdAllocation) {
+    const int perThread = 10000;
+    QVector<TaskId> ids[4];
+    QList<QThread*> threads;
+    for (QVector<TaskId>& out : ids) {
+        threads.append(QThread::create([this, &out]() {
+            for (int i = 0; i < perThread; i++) {
+                out.append(board.allocateTaskId());
+            }
+        }));
+    }
+    for (QThread* thread : threads) {
+        thread->start();
+    }
+    for (QThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    QSet<TaskId> unique;
+    for (const QVector<TaskId>& out : ids) {
+        for (TaskId id : out) {
+            unique.insert(id);
+        }
+    }
+    EXPECT_EQ(unique.size(), 4 * perThread); // Без повторов
+    EXPECT_EQ(board.allocateTaskId(), 4 * perThread + 1); // И без пропусков
+}
+
+// ========== ТЕСТЫ ПАРАЛЛЕЛЬНОЙ ЗАГРУЗКИ ==========
+
+TEST_F(BoardTest, ParallelLoadMatchesSequential) {
+    Developer* dev = board.addDeveloper(Developer("Иван", "Developer"));
+    for (int i = 0; i < 3000; i++) {
+        Task* task = board.addTask(Task(QString("Задача \"%1\"").arg(i), "Строка 1\nСтрока 2"));
+        task->setStatus(static_cast<TaskStatus>(i % 5));
+        if (i % 3 == 0) {
+            task->assignToDeveloper(dev->getId());
+        }
+        if (i % 7 == 0) {
+            task->setDeadline(QDateTime::currentDateTime().addDays(i % 20));
+        }
+    }
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+
+    Board sequential;
+    ASSERT_TRUE(sequential.loadFromFile("test_board.json"));
+    for (int threads : {1, 3, 8}) {
+        Board parallel;
+        ASSERT_TRUE(parallel.loadFromFileParallel("test_board.json", threads));
+        ASSERT_EQ(parallel.getTasks().size(), sequential.getTasks().size());
+        EXPECT_EQ(parallel.getDevelopers().size(), 1);
+
+        for (int i = 0; i < sequential.getTasks().size(); i++) { // Порядок файла сохранен
+            const Task& expected = sequential.getTasks()[i];
+            const Task& actual = parallel.getTasks()[i];
+            ASSERT_EQ(actual.getId(), expected.getId());
+            EXPECT_EQ(actual.getTitle(), expected.getTitle());
+            EXPECT_EQ(actual.getStatus(), expected.getStatus());
+            EXPECT_EQ(actual.getAssignedDeveloperId(), expected.getAssignedDeveloperId());
+            EXPECT_EQ(actual.getDeadline(), expected.getDeadline());
+            EXPECT_EQ(actual.getHistory().size(), expected.getHistory().size());
+        }
+        EXPECT_EQ(parallel.countByDeveloper(dev->getId()), sequential.countByDeveloper(dev->getId()));
+    }
+}
+
+TEST_F(BoardTest, ParallelLoadReservesIds) {
+    QFile file("test_board.json");
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(R"({"developers": [], "tasks": [{"id": 900001, "title": "A"}, {"id": 5, "title": "B"}]})");
+    file.close();
+
+    ASSERT_TRUE(board.loadFromFileParallel("test_board.json", 2));
+    EXPECT_EQ(board.addTask(Task("Новая"))->getId(), 900002); // Загруженные ID зарезервированы доской
+}
+
+TEST_F(BoardTest, ParallelLoadRejectsDamagedJson) {
+    board.addTask(Task("Старая задача"));
+
+    QFile file("test_board.json");
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(R"({"tasks": [{"title": "A"}, {"title": "B",}]})");
+    file.close();
+
+    EXPECT_FALSE(board.loadFromFileParallel("test_board.json"));
+    ASSERT_EQ(board.getTasks().size(), 1);
+    EXPECT_EQ(board.getTasks()[0].getTitle(), "Старая задача");
+}
+
+// Замер масштабирования на синтетической доске из 500 тыс. задач.
+// Запуск: ./scrum_board_tests --gtest_also_run_disabled_tests --gtest_filter=*ParallelLoadScaling*
+TEST_F(BoardTest, DISABLED_ParallelLoadScaling) {
+    for (int i = 0; i < 500000; i++) {
+        Task* task = board.addTask(Task(QString("Задача %1").arg(i), "Описание синтетической задачи"));
+        task->setStatus(static_cast<TaskStatus>(i % 5));
+        task->setDeadline(QDateTime::currentDateTime().addDays(i % 30));
+    }
+    ASSERT_TRUE(board.saveToFile("test_board.json", Board::FileFormat::JsonCompact));
+    board.clear();
+
+    QElapsedTimer timer;
+    timer.start();
+    ASSERT_TRUE(board.loadFromFile("test_board.json"));
+    RecordProperty("sequential_ms", static_cast<int>(timer.elapsed()));
+
+    for (int threads : {1, 2, 4, 8, QThread::idealThreadCount()}) {
+        Board parallel;
+        timer.restart();
+        ASSERT_TRUE(parallel.loadFromFileParallel("test_board.json", threads));
+        RecordProperty(QString("parallel_%1_threads_ms").arg(threads).toStdString(),
+                       static_cast<int>(timer.elapsed()));
+        EXPECT_EQ(parallel.getTasks().size(), 500000);
+    }
+}
+
+// ========== ТЕСТЫ БИНАРНОГО ФОРМАТА ==========
+
+TEST_F(BoardTest, BinarySaveAndLoad) {
+    Developer* dev = board.addDeveloper(Developer("Иван", "Developer"));
+
+    Task task("Задача", "Описание");
+    task.setStatus(TaskStatus::Review);
+    task.assignToDeveloper(dev->getId());
+    task.setDeadline(QDateTime::currentDateTime().addDays(3));
+    task.addHistoryEntry("Комментарий", "Детали");
+    Task* stored = board.addTask(task);
+    board.addTask(Task("Без дедлайна"));
+
+    EXPECT_TRUE(board.saveToFile("test_board.sbb", Board::FileFormat::Binary));
+
+    Board newBoard;
+    EXPECT_TRUE(newBoard.loadFromFile("test_board.sbb"));
+
+    ASSERT_EQ(newBoard.getDevelopers().size(), 1);
+    EXPECT_EQ(newBoard.getDevelopers()[0].getId(), dev->getId());
+    EXPECT_EQ(newBoard.getDevelopers()[0].getName(), "Иван");
+    EXPECT_EQ(newBoard.getDevelopers()[0].getPosition(), "Developer");
+
+    ASSERT_EQ(newBoard.getTasks().size(), 2);
+    const Task& loaded = newBoard.getTasks()[0];
+    EXPECT_EQ(loaded.getId(), stored->getId());
+    EXPECT_EQ(loaded.getTitle(), "Задача");
+    EXPECT_EQ(loaded.getDescription(), "Описание");
+    EXPECT_EQ(loaded.getStatus(), TaskStatus::Review);
+    EXPECT_EQ(loaded.getAssignedDeveloperId(), dev->getId());
+    // Время хранится целыми миллисекундами - без потери точности
+    EXPECT_EQ(loaded.getDeadline().toMSecsSinceEpoch(), stored->getDeadline().toMSecsSinceEpoch());
+    EXPECT_FALSE(newBoard.getTasks()[1].hasDeadline());
+
+    QList<TaskHistoryEntry> expectedHistory = stored->getHistory();
+    QList<TaskHistoryEntry> loadedHistory = loaded.getHistory();
+    ASSERT_EQ(loadedHistory.size(), expectedHistory.size());
+    for (int i = 0; i < loadedHistory.size(); i++) {
+        const TaskHistoryEntry& expected = expectedHistory[i];
+        const TaskHistoryEntry& actual = loadedHistory[i];
+        EXPECT_EQ(actual.getAction(), expected.getAction());
+        EXPECT_EQ(actual.getDetails(), expected.getDetails());
+        EXPECT_EQ(actual.getTimestamp().toMSecsSinceEpoch(), expected.getTimestamp().toMSecsSinceEpoch());
+    }
+
+    // Индексы восстанавливаются так же, как при загрузке JSON
+    EXPECT_EQ(newBoard.countByStatus(TaskStatus::Review), 1);
+    EXPECT_EQ(newBoard.countByDeveloper(dev->getId()), 1);
+}
+
+TEST_F(BoardTest, LoadDetectsFormat) {
+    board.addTask(Task("Задача"));
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+    EXPECT_TRUE(board.saveToFile("test_board.sbb", Board::FileFormat::Binary));
+
+    QFile json("test_board.json");
+    ASSERT_TRUE(json.open(QIODevice::ReadOnly));
+    EXPECT_FALSE(BoardBinaryFormat::isBinary(json.peek(3)));
+    QFile binary("test_board.sbb");
+    ASSERT_TRUE(binary.open(QIODevice::ReadOnly));
+    EXPECT_TRUE(BoardBinaryFormat::isBinary(binary.peek(3)));
+
+    Board fromJson;
+    Board fromBinary;
+    EXPECT_TRUE(fromJson.loadFromFile("test_board.json"));
+    EXPECT_TRUE(fromBinary.loadFromFile("test_board.sbb"));
+    EXPECT_EQ(fromJson.getTasks()[0].getTitle(), fromBinary.getTasks()[0].getTitle());
+}
+
+TEST_F(BoardTest, CorruptBinaryKeepsBoard) {
+    board.addTask(Task("Старая задача"));
+
+    QFile file("test_board.sbb");
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray::fromHex("d9d9f7a1")); // Сигнатура и обрезанная карта
+    file.close();
+
+    EXPECT_FALSE(board.loadFromFile("test_board.sbb"));
+    ASSERT_EQ(board.getTasks().size(), 1);
+    EXPECT_EQ(board.getTasks()[0].getTitle(), "Старая задача");
+}
+
+// Замер: доска с длинной историей в JSON и в бинарном формате
+TEST_F(BoardTest, BinaryFormatIsSmallerAndFaster) {
+    for (int i = 0; i < 500; i++) {
+        Task* task = board.addTask(Task(QString("Задача %1").arg(i), "Описание задачи"));
+        task->setDeadline(QDateTime::currentDateTime().addDays(i % 30));
+        for (int j = 0; j < 20; j++) {
+            task->addHistoryEntry("Изменение статуса", QString("Шаг %1").arg(j));
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    EXPECT_TRUE(board.saveToFile("test_board.json"));
+    qint64 jsonSaveNs = timer.nsecsElapsed();
+    timer.restart();
+    EXPECT_TRUE(board.saveToFile("test_board.sbb", Board::FileFormat::Binary));
+    qint64 binarySaveNs = timer.nsecsElapsed();
+
+    Board jsonBoard;
+    timer.restart();
+    EXPECT_TRUE(jsonBoard.loadFromFile("test_board.json"));
+    qint64 jsonLoadNs = timer.nsecsElapsed();
+    Board binaryBoard;
+    timer.restart();
+    EXPECT_TRUE(binaryBoard.loadFromFile("test_board.sbb"));
+    qint64 binaryLoadNs = timer.nsecsElapsed();
+
+    EXPECT_EQ(binaryBoard.getTasks().size(), jsonBoard.getTasks().size());
+    EXPECT_LT(QFileInfo("test_board.sbb").size(), QFileInfo("test_board.json").size() / 2);
+
+    RecordProperty("json_bytes", static_cast<int>(QFileInfo("test_board.json").size()));
+    RecordProperty("binary_bytes", static_cast<int>(QFileInfo("test_board.sbb").size()));
+    RecordProperty("json_save_us", static_cast<int>(jsonSaveNs / 1000));
+    RecordProperty("binary_save_us", static_cast<int>(binarySaveNs / 1000));
+    RecordProperty("json_load_us", static_cast<int>(jsonLoadNs / 1000));
+    RecordProperty("binary_load_us", static_cast<int>(binaryLoadNs / 1000));
+}
+
+// ========== ТЕСТЫ СНИМКА И ФОНОВОГО СОХРАНЕНИЯ ==========
+
+TEST_F(BoardTest, SnapshotIsIsolatedFromEdits) {
+    board.addDeveloper(Developer("Иван", "Dev"));
+    Task* task = board.addTask(Task("Исходная", "Описание"));
+    TaskId removedId = board.addTask(Task("Будет удалена"))->getId();
+
+    BoardSnapshot snapshot(board);
+
+    // Правки доски после снимка не видны в нем
+    task->setTitle("Измененная");
+    task->setStatus(TaskStatus::Done);
+    board.removeTask(removedId);
+    board.addTask(Task("Новая"));
+
+    ASSERT_EQ(snapshot.getTasks().size(), 2);
+    EXPECT_EQ(snapshot.getTasks()[0].getTitle(), "Исходная");
+    EXPECT_EQ(snapshot.getTasks()[0].getStatus(), TaskStatus::Backlog);
+    EXPECT_EQ(snapshot.getTasks()[0].getHistory().size(), 1);
+    EXPECT_EQ(snapshot.getTasks()[1].getTitle(), "Будет удалена");
+
+    ASSERT_TRUE(snapshot.saveToFile("test_board.json", Board::FileFormat::Json));
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile("test_board.json"));
+    ASSERT_EQ(loaded.getTasks().size(), 2);
+    EXPECT_EQ(loaded.getTasks()[0].getTitle(), "Исходная");
+    EXPECT_EQ(loaded.getDevelopers().size(), 1);
+}
+
+TEST_F(BoardTest, SnapshotSaveMatchesBoardSave) {
+    board.addDeveloper(Developer("Иван", "Dev"));
+    for (int i = 0; i < 10; i++) {
+        board.addTask(Task(QString("Задача %1").arg(i)))->setStatus(TaskStatus::Review);
+    }
+
+    for (Board::FileFormat format : {Board::FileFormat::Json, Board::FileFormat::Binary}) {
+        QString filename = format == Board::FileFormat::Binary ? "test_board.sbb" : "test_board.json";
+        ASSERT_TRUE(board.saveToFile(filename, format));
+        QFile boardFile(filename);
+        ASSERT_TRUE(boardFile.open(QIODevice::ReadOnly));
+        QByteArray expected = boardFile.readAll();
+        boardFile.close();
+
+        QList<int> reported;
+        ASSERT_TRUE(BoardSnapshot(board).saveToFile(filename, format, [&reported](int written, int total) {
+            EXPECT_EQ(total, 10);
+            reported.append(written);
+        }));
+        QFile snapshotFile(filename);
+        ASSERT_TRUE(snapshotFile.open(QIODevice::ReadOnly));
+        EXPECT_EQ(snapshotFile.readAll(), expected);
+
+        ASSERT_EQ(reported.size(), 10); // Ход записи - по каждой задаче
+        EXPECT_EQ(reported.last(), 10);
+    }
+}
+
+TEST_F(BoardTest, BackgroundSaveWhileEditing) {
+    for (int i = 0; i < 2000; i++) {
+        board.addTask(Task(QString("Задача %1").arg(i)));
+    }
+
+    BoardSaver saver;
+    std::atomic<int> lastWritten{0};
+    std::atomic<int> finishedCount{0};
+    std::atomic<bool> succeeded{false};
+    // Без контекста соединения обработчики выполняются в рабочем потоке
+    QObject::connect(&saver, &BoardSaver::progress, [&lastWritten](const QString&, int written, int) {
+        lastWritten = written;
+    });
+    QObject::connect(&saver, &BoardSaver::finished, [&](const QString& filename, bool success) {
+        EXPECT_EQ(filename, "test_board.json");
+        succeeded = success;
+        finishedCount++;
+    });
+
+    saver.save(BoardSnapshot(board), "test_board.json", Board::FileFormat::Json);
+    board.clear(); // Доска меняется, пока снимок пишется
+    board.addTask(Task("После снимка"));
+
+    saver.waitForFinished();
+    EXPECT_FALSE(saver.isBusy());
+    EXPECT_EQ(finishedCount, 1);
+    EXPECT_TRUE(succeeded);
+    EXPECT_EQ(lastWritten, 2000);
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile("test_board.json"));
+    ASSERT_EQ(loaded.getTasks().size(), 2000);
+    EXPECT_EQ(loaded.getTasks()[1999].getTitle(), "Задача 1999");
+}
+
+TEST_F(BoardTest, BackgroundSaveReportsFailure) {
+    board.addTask(Task("Задача"));
+
+    BoardSaver saver;
+    std::atomic<int> failures{0};
+    QObject::connect(&saver, &BoardSaver::finished, [&failures](const QString&, bool success) {
+        if (!success) {
+            failures++;
+        }
+    });
+
+    saver.save(BoardSnapshot(board), "/nonexistent_directory_12345/test.json", Board::FileFormat::Json);
+    saver.save(BoardSnapshot(board), "test_board.sbb", Board::FileFormat::Binary); // Очередь не прерывается ошибкой
+    saver.waitForFinished();
+
+    EXPECT_EQ(failures, 1);
+    EXPECT_TRUE(QFile::exists("test_board.sbb"));
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../widgets/cardstyle.h"
+#include <QElapsedTimer> // Замер стоимости кадра свечения
+#include <QLinearGradient>
+
+class CardStyleTest : public ::testing::Test {
+protected:
+    Task taskDueIn(int days) {
+        Task task("Задача");
+        task.setDeadline(QDateTime::currentDateTime().addDays(days));
+        return task;
+    }
+
+    // Цвет первой точки градиента (или сплошной цвет)
+    QColor firstColor(const QBrush& brush) {
+        if (brush.gradient()) {
+            return brush.gradient()->stops().first().second;
+        }
+        return brush.color();
+    }
+};
+
+TEST_F(CardStyleTest, UrgencyFollowsDeadline) {
+    EXPECT_EQ(cardUrgency(Task("Без дедлайна")), CardUrgency::None);
+    EXPECT_EQ(cardUrgency(taskDueIn(10)), CardUrgency::None);
+    EXPECT_EQ(cardUrgency(taskDueIn(2)), CardUrgency::Soon);
+    EXPECT_EQ(cardUrgency(taskDueIn(-3)), CardUrgency::Overdue);
+
+    Task done = taskDueIn(-3);
+    done.setStatus(TaskStatus::Done);
+    EXPECT_EQ(cardUrgency(done), CardUrgency::Done); // Завершенная не считается просроченной
+}
+
+TEST_F(CardStyleTest, BackgroundMatchesOldStyleSheetNumbers) {
+    // Без свечения фон совпадает с базовыми цветами карточки
+    EXPECT_EQ(firstColor(cardBackground(CardUrgency::Soon, 0.0)), cardColors(CardUrgency::Soon).background);
+    EXPECT_EQ(firstColor(cardBackground(CardUrgency::Overdue, 0.0)), cardColors(CardUrgency::Overdue).background);
+
+    // Пик свечения: те же числа, что раньше подставлялись в qlineargradient
+    EXPECT_EQ(firstColor(cardBackground(CardUrgency::Overdue, 1.0)), QColor(255, 240, 240));
+    EXPECT_EQ(firstColor(cardBackground(CardUrgency::Today, 1.0)), QColor(255, 250, 180));
+    EXPECT_EQ(firstColor(cardBackground(CardUrgency::Soon, 1.0)), QColor(255, 250, 210));
+
+    const QGradient* gradient = cardBackground(CardUrgency::Overdue, 0.5).gradient();
+    ASSERT_NE(gradient, nullptr);
+    EXPECT_EQ(gradient->stops().size(), 3);
+    EXPECT_EQ(gradient->coordinateMode(), QGradient::ObjectBoundingMode);
+}
+
+TEST_F(CardStyleTest, GlowFrameCost) {
+    // Стоимость одного кадра свечения: прежняя сборка строки стилей (без учета разбора CSS
+    // и переполировки виджетов, которые добавлял setStyleSheet) против числового фона
+    const int frames = 100000;
+
+    QElapsedTimer timer;
+    timer.start();
+    int totalLength = 0;
+    for (int i = 0; i < frames; i++) {
+        int intensity = (i % 100) * 80 / 100;
+        QString bg = QString("qlineargradient(x1:0, y1:0, x2:1, y2:1, "
+                             "stop:0 rgb(%1,%2,%3), "
+                             "stop:0.5 rgb(%4,%5,%6), "
+                             "stop:1 rgb(%7,%8,%9))")
+                         .arg(255).arg(200 + intensity / 2).arg(200 + intensity / 2)
+                         .arg(255).arg(180 + intensity / 2).arg(180 + intensity / 2)
+                         .arg(255).arg(200 + intensity / 2).arg(200 + intensity / 2);
+        totalLength += bg.length();
+    }
+    qint64 legacyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    int totalStops = 0;
+    for (int i = 0; i < frames; i++) {
+        QBrush brush = cardBackground(CardUrgency::Overdue, (i % 100) / 100.0);
+        totalStops += brush.gradient()->stops().size();
+    }
+    qint64 numericNs = timer.nsecsElapsed();
+
+    EXPECT_GT(totalLength, 0);
+    EXPECT_EQ(totalStops, frames * 3);
+    RecordProperty("stylesheet_string_ns_per_frame", static_cast<int>(legacyNs / frames));
+    RecordProperty("numeric_brush_ns_per_frame", static_cast<int>(numericNs / frames));
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h> // Подключаем библиотеку Google Test
 #include "../models/developer.h"
+#include "../models/board.h"
 
 class DeveloperTest : public ::testing::Test {
 };
@@ -142,14 +143,16 @@ TEST_F(DeveloperTest, MultipleChanges) {
 }
 
 TEST_F(DeveloperTest, IdPersistence) { // Постоянство и уникальность ID разработчика
-    Developer dev1("Dev 1", "Position 1");
-    Developer dev2("Dev 2", "Position 2");
+    Board board; // ID выдает доска при добавлении
+    Developer& dev1 = *board.addDeveloper(Developer("Dev 1", "Position 1"));
+    Developer& dev2 = *board.addDeveloper(Developer("Dev 2", "Position 2"));
 
-    int id1 = dev1.getId();
-    int id2 = dev2.getId();
+    DeveloperId id1 = dev1.getId();
+    DeveloperId id2 = dev2.getId();
 
     // ID должны быть разными
     EXPECT_NE(id1, id2);
+    EXPECT_GT(id1, 0);
 
     // ID не должны меняться при изменении полей
     dev1.setName("New Name");
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../widgets/effectsgovernor.h"
+
+class EffectsGovernorTest : public ::testing::Test {
+protected:
+    EffectsGovernor::Settings settings() {
+        EffectsGovernor::Settings s;
+        s.particleBudget = 1000;
+        s.framesToDegrade = 5;
+        s.framesToRecover = 10;
+        return s;
+    }
+
+    // Карточки - любые уникальные адреса
+    int cards[100];
+
+    void feed(EffectsGovernor& governor, int frames, qreal workMs, qreal intervalMs) {
+        for (int i = 0; i < frames; i++) {
+            governor.recordFrame(workMs, intervalMs);
+        }
+    }
+};
+
+TEST_F(EffectsGovernorTest, FullBudgetWhenFewCards) {
+    EffectsGovernor governor(settings());
+    governor.setDemand(&cards[0], 4);
+    governor.setDemand(&cards[1], 1);
+
+    EXPECT_EQ(governor.particleAllowance(4), 160); // Как раньше: intensity * 40
+    EXPECT_EQ(governor.particleAllowance(1), 40);
+    EXPECT_EQ(governor.diagnostics().particlesAllocated, 200);
+    EXPECT_EQ(governor.diagnostics().cardsWithParticles, 2);
+}
+
+TEST_F(EffectsGovernorTest, BudgetGoesToMostUrgentFirst) {
+    EffectsGovernor governor(settings());
+    for (int i = 0; i < 10; i++) {
+        governor.setDemand(&cards[i], 4); // 10 * 160 = 1600 > 1000
+    }
+    for (int i = 10; i < 20; i++) {
+        governor.setDemand(&cards[i], 1);
+    }
+
+    EXPECT_EQ(governor.particleAllowance(4), 100); // Бюджет поделен между просроченными
+    EXPECT_EQ(governor.particleAllowance(1), 0);   // Менее срочным не осталось
+    EXPECT_LE(governor.diagnostics().particlesAllocated, 1000);
+
+    // Снятие запросов освобождает бюджет
+    quint64 version = governor.allocationVersion();
+    for (int i = 0; i < 10; i++) {
+        governor.removeDemand(&cards[i]);
+    }
+    EXPECT_NE(governor.allocationVersion(), version);
+    EXPECT_EQ(governor.particleAllowance(1), 40);
+}
+
+TEST_F(EffectsGovernorTest, VersionChangesOnlyWhenShareChanges) {
+    EffectsGovernor governor(settings());
+    governor.setDemand(&cards[0], 2);
+    quint64 version = governor.allocationVersion();
+
+    governor.setDemand(&cards[1], 2); // Бюджета хватает - доля прежняя
+    governor.setDemand(&cards[1], 2);
+    EXPECT_EQ(governor.allocationVersion(), version);
+}
+
+TEST_F(EffectsGovernorTest, VersionIsPerIntensityLevel) {
+    EffectsGovernor governor(settings());
+    for (int i = 0; i < 5; i++) {
+        governor.setDemand(&cards[i], 4); // 5 * 160 = 800, остается 200
+    }
+    for (int i = 5; i < 10; i++) {
+        governor.setDemand(&cards[i], 1); // 5 * 40 = 200 - ровно в бюджет
+    }
+    quint64 urgentVersion = governor.allocationVersion(4);
+    quint64 lowVersion = governor.allocationVersion(1);
+
+    governor.setDemand(&cards[10], 1); // Доля уровня 1 уменьшается, доля уровня 4 - нет
+    EXPECT_EQ(governor.particleAllowance(1), 200 / 6);
+    EXPECT_EQ(governor.particleAllowance(4), 160);
+    EXPECT_NE(governor.allocationVersion(1), lowVersion);
+    EXPECT_EQ(governor.allocationVersion(4), urgentVersion); // Просроченные карточки частицы не перегенерируют
+}
+
+TEST_F(EffectsGovernorTest, DegradesAndRecoversWithHysteresis) {
+    EffectsGovernor governor(settings());
+    governor.setDemand(&cards[0], 1);
+    governor.setDemand(&cards[1], 4);
+
+    feed(governor, 2, 20.0, 16.0); // Пара тяжелых кадров - уровень не меняется
+    EXPECT_EQ(governor.level(), EffectsGovernor::Full);
+
+    feed(governor, 40, 20.0, 40.0);
+    EXPECT_GT(governor.level(), EffectsGovernor::Full);
+    EXPECT_EQ(governor.particleStride(), 2);
+
+    feed(governor, 200, 20.0, 40.0);
+    EXPECT_EQ(governor.level(), EffectsGovernor::GlowOnly);
+    EXPECT_EQ(governor.particleAllowance(4), 0);
+    EXPECT_EQ(governor.diagnostics().particlesAllocated, 0);
+
+    // Легкие кадры постепенно возвращают качество
+    feed(governor, 1000, 0.5, 16.0);
+    EXPECT_EQ(governor.level(), EffectsGovernor::Full);
+    EXPECT_EQ(governor.particleAllowance(4), 160);
+    EXPECT_LT(governor.diagnostics().averageWorkMs, 1.0);
+}
+
+TEST_F(EffectsGovernorTest, EssentialKeepsOnlyUrgentParticles) {
+    EffectsGovernor governor(settings());
+    governor.setDemand(&cards[0], 1);
+    governor.setDemand(&cards[1], 3);
+    governor.setLevel(EffectsGovernor::Essential);
+
+    EXPECT_EQ(governor.particleAllowance(1), 0);
+    EXPECT_EQ(governor.particleAllowance(3), 30); // Четверть от 120
+}
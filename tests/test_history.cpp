@@ -1,139 +1,137 @@
 #include <gtest/gtest.h> // Подключаем библиотеку Google Test
 #include "../models/task.h"
+#include "../models/board.h"
+#include "../models/boardsegments.h"
+#include "../models/jsonstream.h"
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QDir>
+#include <QFile>
 
 class TaskHistoryEntryTest : public ::testing::Test {
 };
 
 TEST_F(TaskHistoryEntryTest, CreateEntry) { // Создание записи истории
-    TaskHistoryEntry entry; // Создаем объект записи истории
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "Тестовое действие";
-    entry.details = "Детали действия";
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "Тестовое действие", "Детали действия"); // Создаем объект записи истории
 
-    EXPECT_TRUE(entry.timestamp.isValid());
-    EXPECT_EQ(entry.action, "Тестовое действие");
-    EXPECT_EQ(entry.details, "Детали действия");
+    EXPECT_TRUE(entry.getTimestamp().isValid());
+    EXPECT_EQ(entry.getAction(), "Тестовое действие");
+    EXPECT_EQ(entry.getDetails(), "Детали действия");
 }
 
 TEST_F(TaskHistoryEntryTest, JsonSerialization) { // Сериализация и десериализация в/из JSON
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "Создание задачи";
-    entry.details = "Задача 'Тест' создана";
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "Создание задачи", "Задача 'Тест' создана");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_EQ(loaded.action, entry.action);
-    EXPECT_EQ(loaded.details, entry.details);
+    EXPECT_EQ(loaded.getAction(), entry.getAction());
+    EXPECT_EQ(loaded.getDetails(), entry.getDetails());
 
     // Сравниваем время с точностью до секунды
-    EXPECT_EQ(loaded.timestamp.toString(Qt::ISODate),
-              entry.timestamp.toString(Qt::ISODate));
+    EXPECT_EQ(loaded.getTimestamp().toString(Qt::ISODate),
+              entry.getTimestamp().toString(Qt::ISODate));
 }
 
 TEST_F(TaskHistoryEntryTest, EmptyFields) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "";
-    entry.details = "";
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "", "");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_TRUE(loaded.action.isEmpty());
-    EXPECT_TRUE(loaded.details.isEmpty());
-    EXPECT_TRUE(loaded.timestamp.isValid());
+    EXPECT_TRUE(loaded.getAction().isEmpty());
+    EXPECT_TRUE(loaded.getDetails().isEmpty());
+    EXPECT_TRUE(loaded.getTimestamp().isValid());
+}
+
+TEST_F(TaskHistoryEntryTest, MalformedElementHasEmptyAction) { // Испорченный элемент не берет чужое действие
+    TaskHistoryEntry interned(QDateTime::currentDateTime(), "Действие из таблицы", "");
+    EXPECT_EQ(interned.getAction(), "Действие из таблицы");
+    EXPECT_TRUE(TaskHistoryEntry().getAction().isEmpty());
+
+    JsonStreamReader json(QByteArray("42"));
+    TaskHistoryEntry fromJson = TaskHistoryEntry::fromJsonStream(json);
+    EXPECT_TRUE(fromJson.getAction().isEmpty());
+    EXPECT_TRUE(fromJson.getDetails().isEmpty());
+
+    QCborStreamReader cbor(QCborValue(42).toCbor());
+    TaskHistoryEntry fromCbor = TaskHistoryEntry::fromCbor(cbor, QStringList() << "Действие из таблицы");
+    EXPECT_TRUE(fromCbor.getAction().isEmpty());
+
+    // То же внутри задачи: история разбирается при обходе
+    JsonStreamReader taskJson(QByteArray(R"({"title":"Задача","history":[42]})"));
+    Task task = Task::fromJsonStream(taskJson);
+    ASSERT_EQ(task.getHistorySize(), 1);
+    EXPECT_TRUE(task.getHistory().first().getAction().isEmpty());
 }
 
 TEST_F(TaskHistoryEntryTest, SpecialCharactersInDetails) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "Изменение";
-    entry.details = "Название: 'Старое' → 'Новое' (с \"кавычками\")";
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "Изменение", "Название: 'Старое' → 'Новое' (с \"кавычками\")");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_EQ(loaded.details, entry.details);
+    EXPECT_EQ(loaded.getDetails(), entry.getDetails());
 }
 
 TEST_F(TaskHistoryEntryTest, UnicodeInDetails) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "更新";
-    entry.details = "任务已更新 🎉";
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "更新", "任务已更新 🎉");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_EQ(loaded.action, "更新");
-    EXPECT_EQ(loaded.details, "任务已更新 🎉");
+    EXPECT_EQ(loaded.getAction(), "更新");
+    EXPECT_EQ(loaded.getDetails(), "任务已更新 🎉");
 }
 
 TEST_F(TaskHistoryEntryTest, LongDetails) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "Действие";
-    entry.details = QString("X").repeated(10000);
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "Действие", QString("X").repeated(10000));
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_EQ(loaded.details.length(), 10000);
+    EXPECT_EQ(loaded.getDetails().length(), 10000);
 }
 
 TEST_F(TaskHistoryEntryTest, InvalidTimestamp) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime(); // Невалидный временная метка
-    entry.action = "Действие";
-    entry.details = "Детали";
+    TaskHistoryEntry entry(QDateTime(), "Действие", "Детали"); // Невалидный временная метка
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
     // Даже невалидный timestamp должен сериализоваться
-    EXPECT_FALSE(loaded.timestamp.isValid());
-    EXPECT_EQ(loaded.action, "Действие");
-    EXPECT_EQ(loaded.details, "Детали");
+    EXPECT_FALSE(loaded.getTimestamp().isValid());
+    EXPECT_EQ(loaded.getAction(), "Действие");
+    EXPECT_EQ(loaded.getDetails(), "Детали");
 }
 
 TEST_F(TaskHistoryEntryTest, MultilineDetails) { // Многострочные детали
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = "Обновление";
-    entry.details = "Строка 1\nСтрока 2\nСтрока 3";
+    TaskHistoryEntry entry(QDateTime::currentDateTime(), "Обновление", "Строка 1\nСтрока 2\nСтрока 3");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_EQ(loaded.details, "Строка 1\nСтрока 2\nСтрока 3");
+    EXPECT_EQ(loaded.getDetails(), "Строка 1\nСтрока 2\nСтрока 3");
 }
 
 TEST_F(TaskHistoryEntryTest, FutureTimestamp) { // Будущая временная метка
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime().addYears(10);
-    entry.action = "Будущее действие";
-    entry.details = "Запланировано на будущее";
+    TaskHistoryEntry entry(QDateTime::currentDateTime().addYears(10), "Будущее действие", "Запланировано на будущее");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_TRUE(loaded.timestamp > QDateTime::currentDateTime());
-    EXPECT_EQ(loaded.action, "Будущее действие");
+    EXPECT_TRUE(loaded.getTimestamp() > QDateTime::currentDateTime());
+    EXPECT_EQ(loaded.getAction(), "Будущее действие");
 }
 
 TEST_F(TaskHistoryEntryTest, PastTimestamp) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime().addYears(-10);
-    entry.action = "Прошлое действие";
-    entry.details = "Произошло 10 лет назад";
+    TaskHistoryEntry entry(QDateTime::currentDateTime().addYears(-10), "Прошлое действие", "Произошло 10 лет назад");
 
     QJsonObject json = entry.toJson();
     TaskHistoryEntry loaded = TaskHistoryEntry::fromJson(json);
 
-    EXPECT_TRUE(loaded.timestamp < QDateTime::currentDateTime());
-    EXPECT_EQ(loaded.details, "Произошло 10 лет назад");
+    EXPECT_TRUE(loaded.getTimestamp() < QDateTime::currentDateTime());
+    EXPECT_EQ(loaded.getDetails(), "Произошло 10 лет назад");
 }
 
 // ========== ИНТЕГРАЦИЯ С ЗАДАЧЕЙ ==========
@@ -154,8 +152,244 @@ TEST_F(TaskHistoryEntryTest, IntegrationWithTask) {
 
     // Проверяем что все записи валидны
     for (const TaskHistoryEntry& entry : history) {
-        EXPECT_TRUE(entry.timestamp.isValid());
-        EXPECT_FALSE(entry.action.isEmpty());
-        EXPECT_FALSE(entry.details.isEmpty());
+        EXPECT_TRUE(entry.getTimestamp().isValid());
+        EXPECT_FALSE(entry.getAction().isEmpty());
+        EXPECT_FALSE(entry.getDetails().isEmpty());
+    }
+}
+// ========== СОБЫТИЯ ==========
+
+TEST_F(TaskHistoryEntryTest, EventsRenderLegacyText) { // Текст событий совпадает с прежним форматом файлов
+    TaskHistoryEntry status = TaskHistoryEntry::statusChanged(TaskStatus::Backlog, TaskStatus::Review);
+    EXPECT_EQ(status.getEvent(), HistoryEvent::StatusChanged);
+    EXPECT_EQ(status.getAction(), "Смена статуса");
+    EXPECT_EQ(status.getDetails(), "Backlog → Review");
+
+    TaskHistoryEntry title = TaskHistoryEntry::titleChanged("Старое", "Новое");
+    EXPECT_EQ(title.getAction(), "Изменение названия");
+    EXPECT_EQ(title.getDetails(), "'Старое' → 'Новое'");
+
+    EXPECT_EQ(TaskHistoryEntry::created("Тест").getDetails(), "Задача 'Тест' создана");
+    EXPECT_EQ(TaskHistoryEntry::assigned(42).getDetails(), "Назначен разработчик ID: 42");
+    EXPECT_EQ(TaskHistoryEntry::deadlineChanged(QDateTime()).getDetails(), "Дедлайн удален");
+
+    QDateTime deadline(QDate(2030, 3, 5), QTime(18, 30));
+    EXPECT_EQ(TaskHistoryEntry::deadlineChanged(deadline).getDetails(), "Установлен дедлайн: 05.03.2030");
+}
+
+TEST_F(TaskHistoryEntryTest, KnownTextIsRecognized) { // Загруженный текст снова становится событием
+    QDateTime time = QDateTime::currentDateTime();
+    TaskHistoryEntry status(time, "Смена статуса", "InProgress → Done");
+    EXPECT_EQ(status.getEvent(), HistoryEvent::StatusChanged);
+    EXPECT_EQ(status.getOldValue(), static_cast<int>(TaskStatus::InProgress));
+    EXPECT_EQ(status.getNewValue(), static_cast<int>(TaskStatus::Done));
+    EXPECT_EQ(status.getTimestampMs(), time.toMSecsSinceEpoch());
+
+    TaskHistoryEntry title(time, "Изменение названия", "'A → B' → 'C'");
+    EXPECT_EQ(title.getEvent(), HistoryEvent::TitleChanged);
+    EXPECT_EQ(title.getDetails(), "'A → B' → 'C'");
+
+    TaskHistoryEntry assigned(time, "Назначение", "Назначен разработчик ID: 7");
+    EXPECT_EQ(assigned.getEvent(), HistoryEvent::Assigned);
+    EXPECT_EQ(assigned.getNewValue(), 7);
+
+    TaskHistoryEntry deadline(time, "Изменение дедлайна", "Установлен дедлайн: 05.03.2030");
+    EXPECT_EQ(deadline.getEvent(), HistoryEvent::DeadlineChanged);
+    EXPECT_EQ(deadline.getDetails(), "Установлен дедлайн: 05.03.2030");
+}
+
+TEST_F(TaskHistoryEntryTest, UnexpectedTextStaysCustom) { // Текст, который событие не воспроизведет, не теряется
+    QDateTime time = QDateTime::currentDateTime();
+    for (const QStringList& pair : {QStringList{"Смена статуса", "Backlog -> Done"},
+                                    QStringList{"Назначение", "Назначен разработчик ID: 007"},
+                                    QStringList{"Изменение описания", "Описание дополнено"},
+                                    QStringList{"Комментарий", "Детали"}}) {
+        TaskHistoryEntry entry(time, pair[0], pair[1]);
+        EXPECT_EQ(entry.getEvent(), HistoryEvent::Custom);
+        EXPECT_EQ(entry.getAction(), pair[0]);
+        EXPECT_EQ(entry.getDetails(), pair[1]);
+    }
+}
+
+TEST_F(TaskHistoryEntryTest, EventsCarryNoText) { // Строки хранятся только там, где без них не обойтись
+    Task task("Задача");
+    task.setStatus(TaskStatus::InProgress);
+    task.assignToDeveloper(3);
+    task.setDescription("Описание");
+
+    QList<TaskHistoryEntry> history = task.getHistory();
+    ASSERT_EQ(history.size(), 4);
+    EXPECT_EQ(history[0].getEvent(), HistoryEvent::Created);
+    EXPECT_EQ(history[1].getEvent(), HistoryEvent::StatusChanged);
+    EXPECT_EQ(history[2].getEvent(), HistoryEvent::Assigned);
+    EXPECT_EQ(history[3].getEvent(), HistoryEvent::DescriptionChanged);
+    EXPECT_LE(sizeof(TaskHistoryEntry), 64u);
+}
+
+// ========== ОКНО ИСТОРИИ И АРХИВ ==========
+
+TEST_F(TaskHistoryEntryTest, OldEntriesSpillToArchive) {
+    Board board;
+    board.setHistoryLimit(10);
+    Task* task = board.addTask(Task("Задача"));
+    for (int i = 0; i < 100; i++) {
+        task->setTitle(QString("Название %1").arg(i));
     }
-}
\ No newline at end of file
+
+    EXPECT_LE(task->getRecentHistory().size(), 10); // В памяти - только окно
+    EXPECT_EQ(task->getHistorySize(), 101);
+
+    QList<TaskHistoryEntry> history = task->getHistory(); // Архив читается по запросу
+    ASSERT_EQ(history.size(), 101);
+    EXPECT_EQ(history[0].getEvent(), HistoryEvent::Created);
+    for (int i = 1; i < history.size(); i++) {
+        EXPECT_TRUE(history[i].getDetails().endsWith(QString("'Название %1'").arg(i - 1)));
+    }
+    EXPECT_EQ(history.last().getDetails(), task->getRecentHistory().last().getDetails());
+}
+
+TEST_F(TaskHistoryEntryTest, LimitAppliesToAddedAndLoadedTasks) {
+    Task task("Задача");
+    for (int i = 0; i < 49; i++) {
+        task.addHistoryEntry("Комментарий", QString("Запись %1").arg(i));
+    }
+
+    Board board;
+    board.setHistoryLimit(8);
+    Task* stored = board.addTask(task);
+    EXPECT_LE(stored->getRecentHistory().size(), 8);
+    EXPECT_EQ(stored->getHistorySize(), 50);
+    ASSERT_TRUE(board.saveToFile("test_history.json"));
+
+    Board loaded; // Файл содержит всю историю, и загрузка снова ограничивает окно
+    loaded.setHistoryLimit(8);
+    ASSERT_TRUE(loaded.loadFromFile("test_history.json"));
+    const Task& reloaded = loaded.getTasks()[0];
+    EXPECT_TRUE(reloaded.getRecentHistory().isEmpty()); // Загруженная история - текстом, вне окна
+    EXPECT_EQ(reloaded.getHistorySize(), 50);
+    QList<TaskHistoryEntry> history = reloaded.getHistory();
+    ASSERT_EQ(history.size(), 50);
+    EXPECT_EQ(history[1].getDetails(), "Запись 0");
+
+    Task* edited = loaded.getTask(reloaded.getId()); // Окно ограничивает новые записи
+    for (int i = 0; i < 20; i++) {
+        edited->addHistoryEntry("Комментарий", QString("Новая %1").arg(i));
+    }
+    EXPECT_LE(edited->getRecentHistory().size(), 8);
+    history = edited->getHistory();
+    ASSERT_EQ(history.size(), 70); // Загруженные, затем архив, затем окно
+    EXPECT_EQ(history[49].getDetails(), "Запись 48");
+    EXPECT_EQ(history[50].getDetails(), "Новая 0");
+    EXPECT_EQ(history[69].getDetails(), "Новая 19");
+
+    Board unlimited;
+    unlimited.setHistoryLimit(0);
+    ASSERT_TRUE(unlimited.loadFromFile("test_history.json"));
+    EXPECT_EQ(unlimited.getTasks()[0].getHistory().size(), 50);
+    EXPECT_TRUE(unlimited.getTasks()[0].getRecentHistory().isEmpty()); // Обход не переносит записи в окно
+    QFile::remove("test_history.json");
+}
+
+TEST_F(TaskHistoryEntryTest, UntouchedLoadedHistorySavesWithoutDecoding) { // Длинная история без правок не разбирается
+    Board board;
+    board.setHistoryLimit(0);
+    Task* task = board.addTask(Task("Задача"));
+    for (int i = 0; i < 100; i++) {
+        task->addHistoryEntry("Комментарий", QString("path %1/step").arg(i));
+    }
+    ASSERT_TRUE(board.saveToFile("test_history.json"));
+
+    // Экранирование "\/" допустимо, но Qt его не пишет: разобранная и записанная заново запись его потеряет
+    QFile file("test_history.json");
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QByteArray text = file.readAll().replace("/step", "\\/step");
+    file.close();
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(text);
+    file.close();
+
+    Board loaded; // Лимит по умолчанию меньше длины истории
+    ASSERT_TRUE(loaded.loadFromFile("test_history.json"));
+    const Task& reloaded = loaded.getTasks()[0];
+    EXPECT_EQ(reloaded.getHistorySize(), 101);
+    EXPECT_TRUE(reloaded.getRecentHistory().isEmpty());
+
+    ASSERT_TRUE(loaded.saveToFile("test_history_copy.json"));
+    QFile copy("test_history_copy.json");
+    ASSERT_TRUE(copy.open(QIODevice::ReadOnly));
+    EXPECT_EQ(copy.readAll(), text); // Текст перенесен как есть
+    copy.close();
+
+    ASSERT_TRUE(loaded.saveToFile("test_history_copy.json", Board::FileFormat::JsonCompact));
+    ASSERT_TRUE(copy.open(QIODevice::ReadOnly));
+    QByteArray compact = copy.readAll();
+    copy.close();
+    EXPECT_TRUE(compact.contains("\\/step")); // Отступы другие, записи те же
+    EXPECT_EQ(QJsonDocument::fromJson(compact), QJsonDocument::fromJson(text));
+
+    EXPECT_TRUE(reloaded.getRecentHistory().isEmpty());
+    EXPECT_EQ(reloaded.getHistory()[1].getDetails(), "path 0/step");
+    QFile::remove("test_history.json");
+    QFile::remove("test_history_copy.json");
+}
+
+TEST_F(TaskHistoryEntryTest, CopyOutlivesBoardArchive) { // Снимок задачи читает архив и после очистки доски
+    Task copy;
+    {
+        Board board;
+        board.setHistoryLimit(4);
+        Task* task = board.addTask(Task("Задача"));
+        for (int i = 0; i < 20; i++) {
+            task->setDescription(QString("Описание %1").arg(i));
+        }
+        copy = *task;
+        board.clear();
+    }
+    EXPECT_EQ(copy.getHistorySize(), 21);
+    EXPECT_EQ(copy.getHistory().size(), 21);
+}
+
+TEST_F(TaskHistoryEntryTest, UnreadableArchiveFailsSave) { // Неполная история не попадает в файл молча
+    QDir temp(QDir::tempPath());
+    const QStringList pattern("scrum-board-history-*");
+    QStringList before = temp.entryList(pattern, QDir::Files);
+
+    Board board;
+    board.setHistoryLimit(4);
+    Task* task = board.addTask(Task("Задача"));
+    for (int i = 0; i < 20; i++) {
+        task->setDescription(QString("Описание %1").arg(i));
+    }
+    ASSERT_TRUE(board.saveToFile("test_history.json"));
+    QFile saved("test_history.json");
+    ASSERT_TRUE(saved.open(QIODevice::ReadOnly));
+    QByteArray good = saved.readAll();
+    saved.close();
+
+    // Архив этой доски - единственный новый файл архива; затираем его
+    QStringList created = temp.entryList(pattern, QDir::Files);
+    for (const QString& name : before) {
+        created.removeAll(name);
+    }
+    ASSERT_EQ(created.size(), 1);
+    QFile archive(temp.filePath(created.first()));
+    ASSERT_TRUE(archive.open(QIODevice::ReadWrite));
+    archive.write(QByteArray(int(archive.size()), '\0'));
+    archive.close();
+
+    bool complete = true;
+    EXPECT_LT(task->getHistory(&complete).size(), 21);
+    EXPECT_FALSE(complete);
+
+    for (Board::FileFormat format : {Board::FileFormat::Json, Board::FileFormat::JsonCompact, Board::FileFormat::Binary}) {
+        EXPECT_FALSE(board.saveToFile("test_history.json", format));
+    }
+    EXPECT_FALSE(board.saveToFile("test_history.sbs", Board::FileFormat::Segmented));
+    EXPECT_FALSE(QFile::exists("test_history.sbs")); // Манифест без сегментов не записан
+
+    ASSERT_TRUE(saved.open(QIODevice::ReadOnly));
+    EXPECT_EQ(saved.readAll(), good); // Прежний файл не подменен неполным
+    saved.close();
+    QFile::remove("test_history.json");
+    QDir(BoardSegmentStore::directoryFor("test_history.sbs")).removeRecursively();
+}
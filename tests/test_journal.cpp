@@ -0,0 +1,289 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../models/board.h"
+#include "../models/boardjournal.h"
+#include "../models/boardsaver.h"
+#include "../models/boardsnapshot.h"
+#include <QFile>
+
+class JournalTest : public ::testing::Test {
+protected:
+    const QString boardFile = "test_journal.json";
+    const QString journalFile = BoardJournal::pathFor("test_journal.json");
+    Board board;
+
+    void SetUp() override {
+        Developer* dev = board.addDeveloper(Developer("Иван", "Dev"));
+        for (int i = 0; i < 5; i++) {
+            board.addTask(Task(QString("Задача %1").arg(i)))->assignToDeveloper(dev->getId());
+        }
+        ASSERT_TRUE(board.saveToFile(boardFile));
+        ASSERT_TRUE(board.openJournal(boardFile));
+    }
+
+    void TearDown() override {
+        board.closeJournal();
+        for (const QString& file : {boardFile, QString("test_journal_copy.json"), QString("test_journal_compare.json")}) {
+            QFile::remove(file);
+            QFile::remove(BoardJournal::pathFor(file));
+            QFile::remove(BoardJournal::pathFor(file) + ".next");
+        }
+    }
+
+    static QByteArray readFile(const QString& filename) {
+        QFile file(filename);
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+
+    // Текст доски в JSON: одинаковый текст - одинаковое содержимое вместе с историей
+    static QByteArray serialized(Board& source) {
+        EXPECT_TRUE(source.saveToFile("test_journal_compare.json"));
+        return readFile("test_journal_compare.json");
+    }
+
+    // Доска, которую увидит следующий запуск после сбоя
+    void expectRecovered(const QString& filename = "test_journal.json") {
+        Board recovered;
+        ASSERT_TRUE(recovered.loadFromFile(filename));
+        EXPECT_EQ(serialized(recovered), serialized(board));
+    }
+
+    // Изменения всех видов, которые пишет журнал
+    void editBoard(const QString& tag) {
+        Developer* dev = board.addDeveloper(Developer("Разработчик " + tag, "QA"));
+        Task* task = board.addTask(Task("Новая " + tag, "Описание"));
+        task->setTitle("Переименована " + tag);
+        task->setDescription("Другое описание");
+        task->setStatus(TaskStatus::InProgress);
+        task->assignToDeveloper(dev->getId());
+        task->setDeadline(QDateTime::currentDateTime().addDays(3));
+
+        Task* first = &board.getTasks()[0];
+        first->setStatus(TaskStatus::Review);
+        first->unassign();
+        board.removeTask(board.getTasks()[1].getId());
+        board.removeDeveloper(dev->getId()); // Снимает назначение с задачи
+    }
+};
+
+TEST_F(JournalTest, ReplayRestoresEveryKindOfChange) {
+    editBoard("A");
+    ASSERT_TRUE(board.syncJournal());
+
+    // Файл доски не менялся: все изменения только в журнале
+    expectRecovered();
+}
+
+TEST_F(JournalTest, RecordsReachDiskInBatches) {
+    board.getTasks()[0].setTitle("Не сброшено");
+    Board before;
+    ASSERT_TRUE(before.loadFromFile(boardFile));
+    EXPECT_EQ(before.getTasks()[0].getTitle(), "Задача 0"); // Запись еще в памяти
+
+    for (int i = 0; i < BoardJournal::BatchRecords; i++) {
+        board.getTasks()[1].setTitle(QString("Версия %1").arg(i));
+    }
+    Board after; // Полная пачка сброшена без вызова syncJournal
+    ASSERT_TRUE(after.loadFromFile(boardFile));
+    EXPECT_EQ(after.getTasks()[0].getTitle(), "Не сброшено");
+}
+
+TEST_F(JournalTest, TornTailIsIgnored) {
+    board.getTasks()[0].setStatus(TaskStatus::Done);
+    ASSERT_TRUE(board.syncJournal());
+    QByteArray expected = serialized(board);
+
+    // Оборванная при сбое запись: заголовок обещает больше байт, чем есть
+    QFile journal(journalFile);
+    ASSERT_TRUE(journal.open(QIODevice::Append));
+    journal.write(QByteArray("\x40\x00\x00\x00\x12\x34\x56\x78\xA1", 9));
+    journal.close();
+
+    Board recovered;
+    ASSERT_TRUE(recovered.loadFromFile(boardFile));
+    EXPECT_EQ(serialized(recovered), expected);
+}
+
+TEST_F(JournalTest, CompactionKeepsChangesMadeDuringSave) {
+    editBoard("A");
+    BoardSnapshot snapshot = board.beginCompaction(boardFile);
+    EXPECT_TRUE(board.isCompacting());
+    editBoard("B"); // Пока снимок пишется в фоне
+    FileFingerprint written;
+    ASSERT_TRUE(snapshot.saveToFile(boardFile, Board::FileFormat::Json, BoardSnapshot::Progress(), &written));
+    EXPECT_EQ(written, FileFingerprint::of(boardFile)); // Отпечаток, посчитанный по ходу записи
+    ASSERT_TRUE(board.finishCompaction(true, written));
+    EXPECT_FALSE(board.isCompacting());
+    editBoard("C");
+    ASSERT_TRUE(board.syncJournal());
+
+    EXPECT_FALSE(QFile::exists(journalFile + ".next"));
+    expectRecovered();
+}
+
+TEST_F(JournalTest, CrashBeforeSnapshotIsWritten) {
+    editBoard("A");
+    board.beginCompaction(boardFile);
+    editBoard("B");
+    ASSERT_TRUE(board.syncJournal());
+
+    // Старый снимок + основной журнал + следующий журнал
+    expectRecovered();
+}
+
+TEST_F(JournalTest, CrashAfterSnapshotIsWritten) {
+    editBoard("A");
+    BoardSnapshot snapshot = board.beginCompaction(boardFile);
+    editBoard("B");
+    ASSERT_TRUE(snapshot.saveToFile(boardFile, Board::FileFormat::Json));
+    ASSERT_TRUE(board.syncJournal());
+
+    // Новый снимок: старый основной журнал уже в нем, применяется только следующий
+    expectRecovered();
+}
+
+TEST_F(JournalTest, FailedCompactionReturnsRecordsToJournal) {
+    editBoard("A");
+    board.beginCompaction(boardFile);
+    editBoard("B");
+    EXPECT_TRUE(board.finishCompaction(false, FileFingerprint())); // Снимок не записан, журнал продолжается
+    editBoard("C");
+    ASSERT_TRUE(board.syncJournal());
+
+    EXPECT_FALSE(QFile::exists(journalFile + ".next"));
+    expectRecovered();
+}
+
+TEST_F(JournalTest, SaveAsMovesJournalToNewFile) {
+    editBoard("A");
+    ASSERT_TRUE(board.syncJournal());
+    QByteArray original = serialized(board);
+
+    BoardSnapshot snapshot = board.beginCompaction("test_journal_copy.json");
+    editBoard("B");
+    FileFingerprint written;
+    ASSERT_TRUE(snapshot.saveToFile("test_journal_copy.json", Board::FileFormat::Json, BoardSnapshot::Progress(), &written));
+    ASSERT_TRUE(board.finishCompaction(true, written));
+    editBoard("C");
+    ASSERT_TRUE(board.syncJournal());
+    EXPECT_EQ(board.journalFile(), "test_journal_copy.json");
+
+    expectRecovered("test_journal_copy.json");
+
+    Board old; // Прежний файл остался со своим журналом
+    ASSERT_TRUE(old.loadFromFile(boardFile));
+    EXPECT_EQ(serialized(old), original);
+}
+
+TEST_F(JournalTest, JournalOfOtherFileVersionIsIgnored) {
+    board.getTasks()[0].setTitle("Только в журнале");
+    ASSERT_TRUE(board.syncJournal());
+
+    Board other; // Файл перезаписан в обход журнала
+    other.addTask(Task("Другая доска"));
+    ASSERT_TRUE(other.saveToFile(boardFile));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(boardFile));
+    ASSERT_EQ(loaded.getTasks().size(), 1);
+    EXPECT_EQ(loaded.getTasks()[0].getTitle(), "Другая доска");
+}
+
+TEST_F(JournalTest, SameSizeRewriteWithSameTimeIsDetected) {
+    board.getTasks()[0].setTitle("Только в журнале");
+    ASSERT_TRUE(board.syncJournal());
+
+    // Файл переписан в обход журнала тем же размером, время изменения возвращено прежнее
+    // (как на файловой системе с грубым временем): журнал к нему не относится
+    QFile file(boardFile);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    QDateTime modified = file.fileTime(QFileDevice::FileModificationTime);
+    QByteArray text = file.readAll();
+    text.replace("Задача 0", "Задача 9");
+    ASSERT_TRUE(file.seek(0));
+    ASSERT_EQ(file.write(text), text.size());
+    file.close();
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(modified, QFileDevice::FileModificationTime));
+    file.close();
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(boardFile));
+    EXPECT_EQ(loaded.getTasks()[0].getTitle(), "Задача 9");
+}
+
+TEST_F(JournalTest, OpenAfterRecoveryCompactsInBackground) {
+    editBoard("A");
+    board.closeJournal();
+    QByteArray fileBefore = readFile(boardFile);
+
+    Board recovered;
+    ASSERT_TRUE(recovered.loadFromFile(boardFile));
+    ASSERT_TRUE(recovered.openJournal(boardFile));
+    EXPECT_EQ(readFile(boardFile), fileBefore); // Файл доски при открытии не переписывается
+    EXPECT_FALSE(QFile::exists(journalFile + ".next"));
+    EXPECT_TRUE(recovered.journalNeedsCompaction()); // Записи прошлой работы ждут снимка
+    expectRecovered(); // Сбой до снимка: записи перенесены в новый журнал
+
+    // Снимок пишет BoardSaver, как при любом сжатии
+    BoardSnapshot snapshot = recovered.beginCompaction(boardFile, Board::formatOf(boardFile));
+    BoardSaver saver;
+    FileFingerprint written;
+    bool saved = false;
+    QObject::connect(&saver, &BoardSaver::finished, [&](const QString&, bool success, const FileFingerprint& fingerprint) {
+        saved = success;
+        written = fingerprint;
+    });
+    saver.save(snapshot, boardFile, Board::formatOf(boardFile));
+    saver.waitForFinished();
+    ASSERT_TRUE(saved);
+    ASSERT_TRUE(recovered.finishCompaction(true, written));
+    EXPECT_FALSE(recovered.journalNeedsCompaction());
+    EXPECT_EQ(QFile(journalFile).size(), 24); // Журнал начинается с пустого
+    recovered.closeJournal();
+
+    expectRecovered();
+}
+
+TEST_F(JournalTest, OpenKeepsCompactJson) {
+    board.closeJournal();
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::JsonCompact));
+    ASSERT_TRUE(board.openJournal(boardFile));
+    editBoard("A");
+    board.closeJournal();
+
+    Board recovered;
+    ASSERT_TRUE(recovered.loadFromFile(boardFile));
+    ASSERT_TRUE(recovered.openJournal(boardFile));
+    EXPECT_EQ(Board::formatOf(boardFile), Board::FileFormat::JsonCompact);
+
+    // Сжатие после восстановления пишет снимок в том же компактном виде
+    Board::FileFormat format = Board::formatOf(boardFile);
+    BoardSnapshot snapshot = recovered.beginCompaction(boardFile, format);
+    FileFingerprint written;
+    ASSERT_TRUE(snapshot.saveToFile(boardFile, format, BoardSnapshot::Progress(), &written));
+    ASSERT_TRUE(recovered.finishCompaction(true, written));
+    EXPECT_EQ(Board::formatOf(boardFile), Board::FileFormat::JsonCompact);
+    expectRecovered();
+}
+
+TEST_F(JournalTest, ParallelLoadBindsToSameVersion) {
+    board.getTasks()[0].setTitle("Только в журнале");
+    ASSERT_TRUE(board.syncJournal());
+
+    Board loaded; // Отпечаток считается по отображенному тексту, пока пул разбирает задачи
+    ASSERT_TRUE(loaded.loadFromFileParallel(boardFile, 2));
+    EXPECT_EQ(loaded.getTasks()[0].getTitle(), "Только в журнале");
+}
+
+TEST_F(JournalTest, ClearStopsJournaling) {
+    EXPECT_TRUE(board.isJournaling());
+    board.clear();
+    EXPECT_FALSE(board.isJournaling());
+    board.addTask(Task("После очистки"));
+    EXPECT_TRUE(board.syncJournal());
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(boardFile));
+    EXPECT_EQ(loaded.getTasks().size(), 5);
+}
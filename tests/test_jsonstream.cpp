@@ -0,0 +1,297 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../models/jsonstream.h"
+#include "../models/task.h"
+#include "../models/developer.h"
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonArray>
+
+class JsonStreamTest : public ::testing::Test {
+protected:
+    QBuffer buffer;
+
+    void open(const QByteArray& text) {
+        buffer.close();
+        buffer.setData(text);
+        buffer.open(QIODevice::ReadOnly);
+    }
+
+    // Проверяем, что потоковый разбор задачи дает то же, что Task::fromJson
+    void expectSameTask(const QByteArray& text, int chunkSize = 64 * 1024) {
+        Task expected = Task::fromJson(QJsonDocument::fromJson(text).object());
+
+        open(text);
+        JsonStreamReader reader(&buffer, chunkSize);
+        Task actual = Task::fromJsonStream(reader);
+        EXPECT_TRUE(reader.atEnd());
+
+        EXPECT_EQ(actual.getId(), expected.getId());
+        EXPECT_EQ(actual.getTitle(), expected.getTitle());
+        EXPECT_EQ(actual.getDescription(), expected.getDescription());
+        EXPECT_EQ(actual.getStatus(), expected.getStatus());
+        EXPECT_EQ(actual.getAssignedDeveloperId(), expected.getAssignedDeveloperId());
+        EXPECT_EQ(actual.getDeadline(), expected.getDeadline());
+
+        QList<TaskHistoryEntry> expectedHistory = expected.getHistory();
+        QList<TaskHistoryEntry> actualHistory = actual.getHistory();
+        ASSERT_EQ(actualHistory.size(), expectedHistory.size());
+        for (int i = 0; i < actualHistory.size(); i++) {
+            EXPECT_EQ(actualHistory[i].getTimestamp(), expectedHistory[i].getTimestamp());
+            EXPECT_EQ(actualHistory[i].getAction(), expectedHistory[i].getAction());
+            EXPECT_EQ(actualHistory[i].getDetails(), expectedHistory[i].getDetails());
+        }
+    }
+};
+
+TEST_F(JsonStreamTest, ReadsValuesOfAllTypes) {
+    open(R"({"s": "a\"b\\c\né😀", "n": -12.5e1, "t": true, "f": false, "z": null, "a": [1, [], {}]})");
+    JsonStreamReader reader(&buffer);
+
+    ASSERT_TRUE(reader.enterObject());
+    QString key;
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_EQ(key, "s");
+    EXPECT_EQ(reader.readString(), QString::fromUtf8("a\"b\\c\né\U0001F600"));
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_DOUBLE_EQ(reader.readNumber(), -125.0);
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_TRUE(reader.readBool());
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_FALSE(reader.readBool());
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_EQ(reader.peekType(), JsonStreamReader::Type::Null);
+    reader.readNull();
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_EQ(key, "a");
+    reader.skipValue();
+    EXPECT_FALSE(reader.nextKey(key));
+
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_FALSE(reader.hasError());
+}
+
+TEST_F(JsonStreamTest, OffsetPointsAtElements) {
+    QByteArray text = R"([ {"a": "x,y"}, [1, 2] ,3])";
+    open(text);
+    JsonStreamReader reader(&buffer, 1);
+
+    ASSERT_TRUE(reader.enterArray());
+    QList<QByteArray> elements;
+    while (reader.nextElement()) {
+        qint64 begin = reader.offset();
+        reader.skipValue();
+        elements.append(text.mid(int(begin), int(reader.offset() - begin)));
+    }
+    EXPECT_EQ(elements, QList<QByteArray>({R"({"a": "x,y"})", "[1, 2]", "3"}));
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST_F(JsonStreamTest, RejectsMalformedInput) {
+    const char* samples[] = {
+        "", "{", "{\"a\":}", "{\"a\":1,}", "[1,]", "[1 2]", "{\"a\" 1}",
+        "\"abc", "01", "1.", "-", "tru", "{\"a\":1} x", "\"a\tb\""
+    };
+    for (const char* sample : samples) {
+        open(sample);
+        JsonStreamReader reader(&buffer);
+        reader.skipValue();
+        EXPECT_FALSE(reader.atEnd()) << sample;
+    }
+}
+
+TEST_F(JsonStreamTest, ConversionsMatchJsonValue) {
+    open(R"([3, 3.0, 2.5, "7", 1e12, null, 42])");
+    JsonStreamReader reader(&buffer);
+
+    ASSERT_TRUE(reader.enterArray());
+    QList<int> values;
+    while (reader.nextElement()) {
+        values.append(reader.toInt(-1));
+    }
+    EXPECT_EQ(values, QList<int>({3, 3, -1, -1, -1, -1, 42}));
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST_F(JsonStreamTest, TaskMatchesDomLoader) {
+    Task task("Задача \"с кавычками\"", "Строка 1\nСтрока 2 — юникод");
+    task.setStatus(TaskStatus::Review);
+    task.assignToDeveloper(5);
+    task.setDeadline(QDateTime::currentDateTime().addDays(2));
+    QByteArray text = QJsonDocument(task.toJson()).toJson();
+
+    expectSameTask(text);
+    expectSameTask(text, 1); // Каждое значение разрезано границами кусков
+    expectSameTask(QJsonDocument(task.toJson()).toJson(QJsonDocument::Compact), 7);
+}
+
+TEST_F(JsonStreamTest, TaskWithMissingAndForeignFields) {
+    // Отсутствующие поля, чужие типы и неизвестные ключи - как у QJsonValue
+    expectSameTask(R"({"id": 12.0, "title": 5, "status": "Done", "extra": {"x": [1, {"y": null}]},
+                       "history": [{"action": "Комментарий"}, 7, {"timestamp": "не дата"}]})");
+    expectSameTask(R"({"assignedDeveloperId": "3", "deadline": "", "history": {}})");
+    expectSameTask("{}");
+}
+
+TEST_F(JsonStreamTest, DeveloperMatchesDomLoader) {
+    QByteArray text = R"({"position": "QA", "id": 77, "name": "Анна"})";
+    Developer expected = Developer::fromJson(QJsonDocument::fromJson(text).object());
+
+    open(text);
+    JsonStreamReader reader(&buffer, 3);
+    Developer actual = Developer::fromJsonStream(reader);
+
+    EXPECT_EQ(actual.getId(), expected.getId());
+    EXPECT_EQ(actual.getName(), expected.getName());
+    EXPECT_EQ(actual.getPosition(), expected.getPosition());
+}
+
+// ========== ПОТОКОВАЯ ЗАПИСЬ ==========
+
+TEST_F(JsonStreamTest, WriterMatchesQJsonDocument) {
+    Task task("Задача \"в кавычках\"", QString("Табуляция\t, \\ и управляющий ") + QChar(0x01));
+    task.setStatus(TaskStatus::InProgress);
+    task.setDeadline(QDateTime::currentDateTime().addDays(1));
+    Task empty;
+    empty.setTitle("Без истории");
+    Developer dev("Анна", "QA");
+
+    for (QJsonDocument::JsonFormat format : {QJsonDocument::Indented, QJsonDocument::Compact}) {
+        QJsonArray array;
+        array.append(task.toJson());
+        array.append(empty.toJson());
+        array.append(dev.toJson());
+
+        buffer.close();
+        buffer.setData(QByteArray());
+        buffer.open(QIODevice::WriteOnly);
+        {
+            JsonStreamWriter writer(&buffer, format, 16); // Маленькие куски: запись идет частями
+            writer.startArray();
+            task.toJsonStream(writer);
+            empty.toJsonStream(writer);
+            dev.toJsonStream(writer);
+            writer.endArray();
+            EXPECT_TRUE(writer.flush());
+        }
+
+        EXPECT_EQ(buffer.data(), QJsonDocument(array).toJson(format));
+    }
+}
+
+TEST_F(JsonStreamTest, WriterOutputReadsBack) {
+    Task task("Задача");
+    task.addHistoryEntry("Комментарий", "Строка 1\nСтрока 2");
+
+    buffer.open(QIODevice::WriteOnly);
+    {
+        JsonStreamWriter writer(&buffer, QJsonDocument::Compact);
+        task.toJsonStream(writer);
+    }
+    open(buffer.data());
+    JsonStreamReader reader(&buffer);
+    Task loaded = Task::fromJsonStream(reader);
+
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(loaded.getTitle(), "Задача");
+    ASSERT_EQ(loaded.getHistory().size(), task.getHistory().size());
+    EXPECT_EQ(loaded.getHistory().last().getDetails(), "Строка 1\nСтрока 2");
+}
+
+TEST_F(JsonStreamTest, RawValueAcrossChunks) {
+    open(R"({"a": [1, {"b": "x]"}, [2, 3]] , "c": 7})");
+    JsonStreamReader reader(&buffer, 3); // Значение пересекает несколько кусков
+
+    ASSERT_TRUE(reader.enterObject());
+    QString key;
+    ASSERT_TRUE(reader.nextKey(key));
+    int count = -1;
+    EXPECT_EQ(reader.readRawValue(&count), QByteArray(R"([1, {"b": "x]"}, [2, 3]])"));
+    EXPECT_EQ(count, 3);
+    ASSERT_TRUE(reader.nextKey(key));
+    EXPECT_EQ(key, "c");
+    EXPECT_EQ(reader.toInt(), 7);
+    EXPECT_FALSE(reader.nextKey(key));
+    EXPECT_FALSE(reader.hasError());
+
+    open(R"([1, 2)"); // Синтаксис проверяется и без разбора
+    JsonStreamReader broken(&buffer, 2);
+    EXPECT_TRUE(broken.readRawValue(&count).isEmpty());
+    EXPECT_TRUE(broken.hasError());
+}
+
+TEST_F(JsonStreamTest, HistoryIsDecodedOnlyOnDemand) {
+    Task task("Задача");
+    task.setStatus(TaskStatus::Review);
+    task.addHistoryEntry("Комментарий", "Детали");
+
+    for (QJsonDocument::JsonFormat format : {QJsonDocument::Indented, QJsonDocument::Compact}) {
+        QBuffer first;
+        first.open(QIODevice::WriteOnly);
+        {
+            JsonStreamWriter writer(&first, format);
+            task.toJsonStream(writer);
+        }
+        open(first.data());
+        JsonStreamReader reader(&buffer);
+        Task loaded = Task::fromJsonStream(reader);
+
+        EXPECT_TRUE(loaded.getRecentHistory().isEmpty()); // Записи еще не разобраны
+        EXPECT_EQ(loaded.getHistorySize(), 3);
+
+        QBuffer second; // Текст переносится без разбора - тот же
+        second.open(QIODevice::WriteOnly);
+        {
+            JsonStreamWriter writer(&second, format);
+            loaded.toJsonStream(writer);
+        }
+        EXPECT_EQ(second.data(), first.data());
+        EXPECT_TRUE(loaded.getRecentHistory().isEmpty()); // Окно не заполняется и после записи
+
+        loaded.setTitle("Новое название"); // Новые записи идут после загруженных
+        QList<TaskHistoryEntry> history = loaded.getHistory();
+        ASSERT_EQ(history.size(), 4);
+        EXPECT_EQ(history[1].getEvent(), HistoryEvent::StatusChanged);
+        EXPECT_EQ(history[2].getDetails(), "Детали");
+        EXPECT_EQ(history[3].getEvent(), HistoryEvent::TitleChanged);
+    }
+}
+
+TEST_F(JsonStreamTest, LoadedHistoryFollowsIndentationOfWriter) {
+    Task task("Задача");
+    task.setStatus(TaskStatus::Review);
+
+    // Текст истории записан с отступами на глубине отдельной задачи, а пишется внутри доски
+    QBuffer standalone;
+    standalone.open(QIODevice::WriteOnly);
+    {
+        JsonStreamWriter writer(&standalone, QJsonDocument::Indented);
+        task.toJsonStream(writer);
+    }
+    open(standalone.data());
+    JsonStreamReader reader(&buffer);
+    Task loaded = Task::fromJsonStream(reader);
+
+    QBuffer nested;
+    nested.open(QIODevice::WriteOnly);
+    {
+        JsonStreamWriter writer(&nested, QJsonDocument::Indented);
+        writer.startArray();
+        loaded.toJsonStream(writer);
+        writer.endArray();
+    }
+    QJsonArray expected;
+    expected.append(task.toJson());
+    EXPECT_EQ(nested.data(), QJsonDocument(expected).toJson(QJsonDocument::Indented));
+}
+
+TEST_F(JsonStreamTest, DomHistoryIsKeptAsArray) {
+    Task task("Задача");
+    task.setStatus(TaskStatus::Done);
+    QJsonObject json = task.toJson();
+
+    Task loaded = Task::fromJson(json);
+    EXPECT_TRUE(loaded.getRecentHistory().isEmpty());
+    EXPECT_EQ(loaded.getHistorySize(), 2);
+    EXPECT_EQ(loaded.toJson().value("history"), json.value("history"));
+    EXPECT_EQ(loaded.getHistory()[1].getDetails(), "Backlog → Done");
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../widgets/particlesystem.h"
+#include <QElapsedTimer> // Замер скорости обновления частиц
+#include <QPointF>
+#include <QColor>
+#include <QRandomGenerator>
+
+namespace {
+
+// Прежняя реализация частиц TaskCard (массив структур) - эталон для замера
+struct LegacyParticle {
+    QPointF position;
+    qreal opacity;
+    qreal size;
+    qreal velocity;
+    QColor color;
+};
+
+void legacyUpdate(QVector<LegacyParticle>& particles, qreal width, qreal height) {
+    for (LegacyParticle& p : particles) {
+        p.position.setY(p.position.y() - p.velocity);
+        p.position.setX(p.position.x() + (QRandomGenerator::global()->generateDouble() - 0.5) * 0.5);
+        p.opacity -= 0.015;
+
+        if (p.position.y() < -10 || p.opacity <= 0 || p.position.x() < 0 || p.position.x() > width) {
+            qreal x = QRandomGenerator::global()->generateDouble() * width;
+            qreal cornerRadius = 12.0;
+            if (x < cornerRadius) {
+                x = cornerRadius + 5;
+            } else if (x > width - cornerRadius) {
+                x = width - cornerRadius - 5;
+            }
+            p.position = QPointF(x, height + 5);
+            p.opacity = 0.6 + QRandomGenerator::global()->generateDouble() * 0.4;
+            p.velocity = 0.3 + QRandomGenerator::global()->generateDouble() * 1.2;
+        }
+    }
+}
+
+} // namespace
+
+class ParticleSystemTest : public ::testing::Test {
+protected:
+    const float width = 250.0f;
+    const float height = 190.0f;
+};
+
+TEST_F(ParticleSystemTest, GenerateFillsBottomArea) {
+    ParticleSystem particles(42);
+    particles.generate(3, width, height);
+
+    EXPECT_GT(particles.size(), 100); // 120 запрошено, в углы попадает немного
+    EXPECT_LE(particles.size(), 120);
+    for (int i = 0; i < particles.size(); i++) {
+        EXPECT_GE(particles.y()[i], height * 0.7f - 0.01f); // Нижние 30% карточки
+        EXPECT_GE(particles.x()[i], 0.0f);
+        EXPECT_LE(particles.x()[i], width);
+        EXPECT_GT(particles.opacity()[i], 0.0f);
+    }
+
+    particles.generate(0, width, height);
+    EXPECT_TRUE(particles.isEmpty());
+}
+
+TEST_F(ParticleSystemTest, SpritesCoverPaletteAndSizes) {
+    ParticleSystem particles(5);
+    particles.generate(4, width, height);
+    ASSERT_FALSE(particles.isEmpty());
+    EXPECT_EQ(particles.intensity(), 4);
+
+    for (int i = 0; i < particles.size(); i++) {
+        int sprite = particles.sprite()[i];
+        EXPECT_LT(sprite, ParticleSystem::SpriteCount);
+        // Радиус спрайта близок к радиусу частицы (в пределах корзины)
+        EXPECT_NEAR(ParticleSystem::spriteRadius(sprite), particles.radius()[i] * 1.5f, 0.5f);
+    }
+
+    // Цвета просроченных - темные, как у прежних "углей"
+    QColor darkest(ParticleSystem::spriteColor(4, 0));
+    QColor lightest(ParticleSystem::spriteColor(4, ParticleSystem::SpriteCount - 1));
+    EXPECT_GE(darkest.red(), 80);
+    EXPECT_LT(lightest.red(), 120);
+}
+
+TEST_F(ParticleSystemTest, SameSeedGivesSameParticles) {
+    ParticleSystem a(7);
+    ParticleSystem b(7);
+    a.generate(2, width, height);
+    b.generate(2, width, height);
+    for (int step = 0; step < 50; step++) {
+        a.step(1.0f, width, height);
+        b.step(1.0f, width, height);
+    }
+
+    ASSERT_EQ(a.size(), b.size());
+    for (int i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a.x()[i], b.x()[i]);
+        EXPECT_EQ(a.y()[i], b.y()[i]);
+    }
+}
+
+TEST_F(ParticleSystemTest, FadedParticlesRespawnBelowCard) {
+    ParticleSystem particles(1);
+    particles.generate(1, width, height);
+
+    // Долгая симуляция: все частицы хотя бы раз погасли и появились заново внутри карточки по X
+    for (int step = 0; step < 500; step++) {
+        particles.step(1.0f, width, height);
+    }
+    for (int i = 0; i < particles.size(); i++) {
+        EXPECT_GE(particles.x()[i], 0.0f);
+        EXPECT_LE(particles.x()[i], width);
+        EXPECT_LE(particles.y()[i], height + 5.0f + 0.01f);
+        EXPECT_GT(particles.opacity()[i], 0.0f);
+        EXPECT_LE(particles.opacity()[i], 1.0f);
+    }
+}
+
+TEST_F(ParticleSystemTest, ThroughputComparedToLegacy) {
+    // Микробенчмарк: 500 срочных карточек по 160 частиц, 100 тиков
+    const int particleCount = 500 * 160;
+    const int steps = 100;
+
+    QVector<ParticleSystem> cards;
+    for (int i = 0; i < 500; i++) {
+        cards.append(ParticleSystem(i + 1)); // Свой генератор у каждой карточки
+        cards.last().generate(4, width, height);
+    }
+
+    QVector<QVector<LegacyParticle>> legacyCards(500);
+    for (int c = 0; c < legacyCards.size(); c++) {
+        for (int i = 0; i < cards[c].size(); i++) {
+            LegacyParticle p;
+            p.position = QPointF(cards[c].x()[i], cards[c].y()[i]);
+            p.opacity = cards[c].opacity()[i];
+            p.size = cards[c].radius()[i];
+            p.velocity = 0.3;
+            p.color = QColor(ParticleSystem::spriteColor(4, cards[c].sprite()[i]));
+            legacyCards[c].append(p);
+        }
+    }
+
+    int total = 0;
+    for (const ParticleSystem& card : cards) {
+        total += card.size();
+    }
+    ASSERT_GT(total, particleCount / 2);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int step = 0; step < steps; step++) {
+        for (QVector<LegacyParticle>& card : legacyCards) {
+            legacyUpdate(card, width, height);
+        }
+    }
+    qint64 legacyNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    timer.restart();
+    for (int step = 0; step < steps; step++) {
+        for (ParticleSystem& card : cards) {
+            card.step(1.0f, width, height);
+        }
+    }
+    qint64 soaNs = qMax<qint64>(1, timer.nsecsElapsed());
+
+    // Частиц в секунду (в миллионах): до и после
+    double updates = double(total) * steps;
+    RecordProperty("legacy_mparticles_per_s", static_cast<int>(updates / legacyNs * 1000.0));
+    RecordProperty("soa_mparticles_per_s", static_cast<int>(updates / soaNs * 1000.0));
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../models/boardreconciler.h"
+#include <QElapsedTimer> // Замер времени сверки
+
+class BoardReconcilerTest : public ::testing::Test {
+protected:
+    Board board;
+    BoardReconciler reconciler;
+    QString filter; // Поисковый запрос, как в MainWindow
+
+    QList<CardOperation> reconcile() {
+        return reconciler.reconcile(board, [this](const Task& task) {
+            return filter.isEmpty() || task.getTitle().contains(filter, Qt::CaseInsensitive);
+        });
+    }
+
+    int count(const QList<CardOperation>& ops, CardOperation::Kind kind) {
+        int result = 0;
+        for (const CardOperation& op : ops) {
+            if (op.kind == kind) result++;
+        }
+        return result;
+    }
+};
+
+TEST_F(BoardReconcilerTest, FirstPassInsertsEverything) {
+    board.addTask(Task("A"));
+    board.addTask(Task("B"));
+    Task c("C");
+    c.setStatus(TaskStatus::Done);
+    board.addTask(c);
+
+    QList<CardOperation> ops = reconcile();
+    EXPECT_EQ(ops.size(), 3);
+    EXPECT_EQ(count(ops, CardOperation::Insert), 3);
+    EXPECT_EQ(reconciler.shownCount(), 3);
+
+    // Позиции вставки - по порядку доски внутри колонки
+    EXPECT_EQ(ops[0].index, 0);
+    EXPECT_EQ(ops[1].index, 1);
+    EXPECT_EQ(ops[2].status, TaskStatus::Done);
+    EXPECT_EQ(ops[2].index, 0);
+
+    EXPECT_TRUE(reconcile().isEmpty()); // Без изменений - без операций
+}
+
+TEST_F(BoardReconcilerTest, SingleStatusChangeIsOneMove) {
+    // Большая доска: смена одного статуса должна дать ровно одну операцию
+    QList<Task*> stored;
+    for (int i = 0; i < 10000; i++) {
+        stored.append(board.addTask(Task(QString("Задача %1").arg(i))));
+    }
+    reconcile();
+
+    stored[5000]->setStatus(TaskStatus::InProgress);
+
+    QElapsedTimer timer;
+    timer.start();
+    QList<CardOperation> ops = reconcile();
+    qint64 elapsed = timer.elapsed();
+
+    ASSERT_EQ(ops.size(), 1);
+    EXPECT_EQ(ops[0].kind, CardOperation::Move);
+    EXPECT_EQ(ops[0].taskId, stored[5000]->getId());
+    EXPECT_EQ(ops[0].previousStatus, TaskStatus::Backlog);
+    EXPECT_EQ(ops[0].status, TaskStatus::InProgress);
+    EXPECT_EQ(ops[0].index, 0);
+    RecordProperty("reconcile_10k_ms", static_cast<int>(elapsed));
+}
+
+TEST_F(BoardReconcilerTest, FieldChangeIsUpdate) {
+    Task* task = board.addTask(Task("Задача"));
+    reconcile();
+
+    task->setTitle("Новое название");
+    QList<CardOperation> ops = reconcile();
+    ASSERT_EQ(ops.size(), 1);
+    EXPECT_EQ(ops[0].kind, CardOperation::Update);
+}
+
+TEST_F(BoardReconcilerTest, RemovedTaskIsRemove) {
+    Task* task = board.addTask(Task("Задача"));
+    board.addTask(Task("Другая"));
+    reconcile();
+
+    TaskId taskId = task->getId();
+    board.removeTask(taskId);
+    QList<CardOperation> ops = reconcile();
+    ASSERT_EQ(ops.size(), 1);
+    EXPECT_EQ(ops[0].kind, CardOperation::Remove);
+    EXPECT_EQ(ops[0].taskId, taskId);
+    EXPECT_EQ(reconciler.shownCount(), 1);
+}
+
+TEST_F(BoardReconcilerTest, FilterInAndOut) {
+    board.addTask(Task("Купить хлеб"));
+    board.addTask(Task("Починить кран"));
+    reconcile();
+
+    filter = "хлеб";
+    QList<CardOperation> ops = reconcile();
+    ASSERT_EQ(ops.size(), 1);
+    EXPECT_EQ(ops[0].kind, CardOperation::Remove);
+
+    filter.clear();
+    ops = reconcile();
+    ASSERT_EQ(ops.size(), 1);
+    EXPECT_EQ(ops[0].kind, CardOperation::Insert);
+    EXPECT_EQ(ops[0].index, 1); // Возвращается на свое место в колонке
+}
+
+TEST_F(BoardReconcilerTest, RemovalsComeBeforePlacements) {
+    Task* a = board.addTask(Task("A"));
+    Task* b = board.addTask(Task("B"));
+    reconcile();
+
+    a->setStatus(TaskStatus::Done);
+    board.removeTask(b->getId());
+    board.addTask(Task("C"));
+
+    QList<CardOperation> ops = reconcile();
+    ASSERT_EQ(ops.size(), 3);
+    EXPECT_EQ(ops[0].kind, CardOperation::Remove);
+    EXPECT_EQ(count(ops, CardOperation::Insert), 1);
+    EXPECT_EQ(count(ops, CardOperation::Move), 1);
+}
+
+TEST_F(BoardReconcilerTest, ReloadedBoardRecreatesCards) {
+    Task* task = board.addTask(Task("Задача"));
+    TaskId taskId = task->getId();
+    reconcile();
+
+    // Та же задача как новый объект (как после загрузки файла)
+    Task copy = *task;
+    board.clear();
+    board.addTask(copy);
+
+    QList<CardOperation> ops = reconcile();
+    ASSERT_EQ(ops.size(), 2);
+    EXPECT_EQ(ops[0].kind, CardOperation::Remove);
+    EXPECT_EQ(ops[1].kind, CardOperation::Insert);
+    EXPECT_EQ(ops[1].taskId, taskId);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h> // Подключаем библиотеку Google Test
+#include "../models/board.h"
+#include "../models/boardsegments.h"
+#include "../models/boardsnapshot.h"
+#include <QDir>
+#include <QElapsedTimer> // Замер полного и частичного сохранения
+#include <QFile>
+
+class SegmentsTest : public ::testing::Test {
+protected:
+    const QString boardFile = "test_segments.sbs";
+    Board board;
+
+    void TearDown() override {
+        for (const QString& file : {boardFile, QString("test_segments_copy.sbs")}) {
+            QFile::remove(file);
+            QDir(BoardSegmentStore::directoryFor(file)).removeRecursively();
+        }
+        QFile::remove("test_segments_compare.json");
+    }
+
+    // Доска на count задач: ID подряд, по три сегмента на 3000 задач
+    void fillBoard(int count) {
+        Developer* dev = board.addDeveloper(Developer("Иван", "Dev"));
+        for (int i = 0; i < count; i++) {
+            Task* task = board.addTask(Task(QString("Задача %1").arg(i), "Описание"));
+            task->setStatus(static_cast<TaskStatus>(i % 5));
+            if (i % 3 == 0) {
+                task->assignToDeveloper(dev->getId());
+            }
+        }
+    }
+
+    // Текст доски в JSON: одинаковый текст - одинаковое содержимое вместе с историей
+    static QByteArray serialized(Board& source) {
+        EXPECT_TRUE(source.saveToFile("test_segments_compare.json"));
+        QFile file("test_segments_compare.json");
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    }
+
+    void expectLoadedEqual(const QString& filename) {
+        Board loaded;
+        ASSERT_TRUE(loaded.loadFromFile(filename));
+        EXPECT_EQ(serialized(loaded), serialized(board));
+    }
+
+    QStringList segmentFiles(const QString& filename) const {
+        return QDir(BoardSegmentStore::directoryFor(filename)).entryList(QStringList() << "*.seg", QDir::Files, QDir::Name);
+    }
+
+    // Имя файла сегмента в каталоге: "<сегмент>-<поколение>.seg"
+    QString segmentFile(qint64 segment) const {
+        for (const QString& name : segmentFiles(boardFile)) {
+            if (name.startsWith(QString("%1-").arg(segment))) {
+                return name;
+            }
+        }
+        return QString();
+    }
+};
+
+TEST_F(SegmentsTest, UnsavedChangesAreTracked) {
+    EXPECT_FALSE(board.hasUnsavedChanges()); // Пустая доска
+
+    Task* task = board.addTask(Task("Задача"));
+    EXPECT_TRUE(board.hasUnsavedChanges());
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    EXPECT_FALSE(board.hasUnsavedChanges());
+
+    quint64 revision = task->getRevision();
+    task->setDescription("Новое описание");
+    EXPECT_GT(task->getRevision(), revision);
+    EXPECT_TRUE(board.hasUnsavedChanges());
+
+    board.clear();
+    EXPECT_FALSE(board.hasUnsavedChanges());
+
+    ASSERT_TRUE(board.loadFromFile(boardFile));
+    EXPECT_FALSE(board.hasUnsavedChanges()); // Загруженная доска совпадает с файлом
+    EXPECT_EQ(board.dirtySegmentCount(), 0);
+}
+
+TEST_F(SegmentsTest, SegmentedSaveAndLoad) {
+    fillBoard(3000);
+    board.getTasks()[10].addHistoryEntry("Комментарий", "Детали");
+    board.getTasks()[2500].setDeadline(QDateTime::currentDateTime().addDays(2));
+
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    EXPECT_EQ(segmentFiles(boardFile).size(), 3);
+    EXPECT_EQ(Board::formatOf(boardFile), Board::FileFormat::Segmented);
+
+    expectLoadedEqual(boardFile);
+}
+
+TEST_F(SegmentsTest, IncrementalSaveRewritesOnlyDirtySegments) {
+    fillBoard(3000);
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    QString first = segmentFile(0);
+    QString second = segmentFile(1);
+    QString third = segmentFile(2);
+
+    board.getTask(1500)->setTitle("Изменена"); // Сегмент 1
+    EXPECT_EQ(board.dirtySegmentCount(), 1);
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    EXPECT_EQ(board.dirtySegmentCount(), 0);
+
+    EXPECT_EQ(segmentFile(0), first);
+    EXPECT_NE(segmentFile(1), second); // Переписан под новым поколением, старый удален
+    EXPECT_EQ(segmentFile(2), third);
+    EXPECT_EQ(segmentFiles(boardFile).size(), 3);
+
+    expectLoadedEqual(boardFile);
+}
+
+TEST_F(SegmentsTest, EmptiedSegmentIsRemoved) {
+    fillBoard(3000);
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+
+    for (TaskId id = 2049; id <= 3000; id++) { // Весь сегмент 2
+        ASSERT_TRUE(board.removeTask(id));
+    }
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    EXPECT_TRUE(segmentFile(2).isEmpty());
+    EXPECT_EQ(segmentFiles(boardFile).size(), 2);
+
+    expectLoadedEqual(boardFile);
+}
+
+TEST_F(SegmentsTest, SaveToAnotherFileWritesEverySegment) {
+    fillBoard(3000);
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    board.getTask(1)->setStatus(TaskStatus::Done);
+
+    ASSERT_TRUE(board.saveToFile("test_segments_copy.sbs", Board::FileFormat::Segmented));
+    EXPECT_EQ(segmentFiles("test_segments_copy.sbs").size(), 3);
+    expectLoadedEqual("test_segments_copy.sbs");
+}
+
+TEST_F(SegmentsTest, ChangesDuringBackgroundSaveStayDirty) {
+    fillBoard(3000);
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+
+    board.getTask(100)->setTitle("До снимка");
+    BoardSnapshot snapshot = board.snapshotFor(boardFile, Board::FileFormat::Segmented);
+    EXPECT_TRUE(snapshot.isPartial());
+    board.getTask(2100)->setTitle("Во время записи"); // Пока снимок пишется в фоне
+    ASSERT_TRUE(snapshot.saveToFile(boardFile, Board::FileFormat::Segmented));
+    board.markSaved(boardFile, Board::FileFormat::Segmented, snapshot.getChangeCount());
+
+    EXPECT_TRUE(board.hasUnsavedChanges());
+    EXPECT_EQ(board.dirtySegmentCount(), 1); // Только сегмент 2
+
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    EXPECT_FALSE(board.hasUnsavedChanges());
+    expectLoadedEqual(boardFile);
+}
+
+TEST_F(SegmentsTest, CorruptSegmentFailsLoad) {
+    fillBoard(3000);
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+
+    // Обрезанный сегмент: манифест обещает больше задач
+    QFile segment(BoardSegmentStore::directoryFor(boardFile) + "/" + segmentFile(1));
+    ASSERT_TRUE(segment.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(segment.resize(segment.size() / 2));
+    segment.close();
+
+    Board loaded;
+    loaded.addTask(Task("Старая задача"));
+    EXPECT_FALSE(loaded.loadFromFile(boardFile));
+    ASSERT_EQ(loaded.getTasks().size(), 1); // Доска не тронута
+    EXPECT_EQ(loaded.getTasks()[0].getTitle(), "Старая задача");
+}
+
+// Замер полного и частичного сохранения доски из 200 тыс. задач.
+// Запуск: ./scrum_board_tests --gtest_also_run_disabled_tests --gtest_filter=*IncrementalSaveTiming*
+TEST_F(SegmentsTest, DISABLED_IncrementalSaveTiming) {
+    fillBoard(200000);
+
+    QElapsedTimer timer;
+    timer.start();
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    RecordProperty("full_save_ms", static_cast<int>(timer.elapsed()));
+
+    board.getTask(123456)->setStatus(TaskStatus::Done);
+    timer.restart();
+    ASSERT_TRUE(board.saveToFile(boardFile, Board::FileFormat::Segmented));
+    RecordProperty("incremental_save_ms", static_cast<int>(timer.elapsed()));
+}
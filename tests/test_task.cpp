@@ -157,6 +157,25 @@ TEST_F(TaskTest, DeadlineEdgeCases) { // Граничные случаи дед
     EXPECT_TRUE(days >= 0 && days <= 1);
 }
 
+TEST_F(TaskTest, DeadlineRelativeToGivenTime) { // Срочность от заданного момента, а не от текущего
+    Task task("Задача");
+    QDateTime now(QDate(2024, 3, 10), QTime(12, 0));
+    EXPECT_EQ(task.daysUntilDeadline(now), 999);
+    EXPECT_FALSE(task.isOverdue(now));
+
+    task.setDeadline(QDateTime(QDate(2024, 3, 13), QTime(18, 0)));
+    EXPECT_EQ(task.daysUntilDeadline(now), 3);
+    EXPECT_FALSE(task.isOverdue(now));
+    EXPECT_TRUE(task.isOverdue(now.addDays(4)));
+
+    task.setStatus(TaskStatus::Done);
+    EXPECT_FALSE(task.isOverdue(now.addDays(4)));
+
+    // Геттеры отдают сами поля задачи, без копии
+    EXPECT_EQ(&task.getTitle(), &task.getTitle());
+    EXPECT_EQ(&task.getDeadline(), &task.getDeadline());
+}
+
 // ========== ТЕСТЫ ИСТОРИИ ИЗМЕНЕНИЙ ==========
 
 TEST_F(TaskTest, HistoryTracking) {
@@ -167,9 +186,9 @@ TEST_F(TaskTest, HistoryTracking) {
     EXPECT_GE(history.size(), 1);
 
     // Проверяем первую запись (создание)
-    EXPECT_EQ(history[0].action, "Создание");
-    EXPECT_TRUE(history[0].details.contains("Новая задача"));
-    EXPECT_TRUE(history[0].timestamp.isValid());
+    EXPECT_EQ(history[0].getAction(), "Создание");
+    EXPECT_TRUE(history[0].getDetails().contains("Новая задача"));
+    EXPECT_TRUE(history[0].getTimestamp().isValid());
 }
 
 TEST_F(TaskTest, HistoryOnTitleChange) {
@@ -182,9 +201,9 @@ TEST_F(TaskTest, HistoryOnTitleChange) {
     EXPECT_EQ(history.size(), initialSize + 1);
 
     TaskHistoryEntry lastEntry = history.last();
-    EXPECT_EQ(lastEntry.action, "Изменение названия");
-    EXPECT_TRUE(lastEntry.details.contains("Старое название"));
-    EXPECT_TRUE(lastEntry.details.contains("Новое название"));
+    EXPECT_EQ(lastEntry.getAction(), "Изменение названия");
+    EXPECT_TRUE(lastEntry.getDetails().contains("Старое название"));
+    EXPECT_TRUE(lastEntry.getDetails().contains("Новое название"));
 }
 
 TEST_F(TaskTest, HistoryOnStatusChange) {
@@ -197,9 +216,9 @@ TEST_F(TaskTest, HistoryOnStatusChange) {
     EXPECT_EQ(history.size(), initialSize + 1);
 
     TaskHistoryEntry lastEntry = history.last();
-    EXPECT_EQ(lastEntry.action, "Смена статуса");
-    EXPECT_TRUE(lastEntry.details.contains("Backlog"));
-    EXPECT_TRUE(lastEntry.details.contains("InProgress"));
+    EXPECT_EQ(lastEntry.getAction(), "Смена статуса");
+    EXPECT_TRUE(lastEntry.getDetails().contains("Backlog"));
+    EXPECT_TRUE(lastEntry.getDetails().contains("InProgress"));
 }
 
 TEST_F(TaskTest, HistoryOnAssignment) {
@@ -212,8 +231,8 @@ TEST_F(TaskTest, HistoryOnAssignment) {
     EXPECT_EQ(history.size(), initialSize + 1);
 
     TaskHistoryEntry lastEntry = history.last();
-    EXPECT_EQ(lastEntry.action, "Назначение");
-    EXPECT_TRUE(lastEntry.details.contains("42"));
+    EXPECT_EQ(lastEntry.getAction(), "Назначение");
+    EXPECT_TRUE(lastEntry.getDetails().contains("42"));
 }
 
 TEST_F(TaskTest, HistoryOnUnassign) {
@@ -227,7 +246,7 @@ TEST_F(TaskTest, HistoryOnUnassign) {
     EXPECT_EQ(history.size(), sizeAfterAssign + 1);
 
     TaskHistoryEntry lastEntry = history.last();
-    EXPECT_EQ(lastEntry.action, "Снятие назначения");
+    EXPECT_EQ(lastEntry.getAction(), "Снятие назначения");
 }
 
 TEST_F(TaskTest, HistoryOnDeadlineChange) {
@@ -241,8 +260,8 @@ TEST_F(TaskTest, HistoryOnDeadlineChange) {
     EXPECT_EQ(history.size(), initialSize + 1);
 
     TaskHistoryEntry lastEntry = history.last();
-    EXPECT_EQ(lastEntry.action, "Изменение дедлайна");
-    EXPECT_TRUE(lastEntry.details.contains("дедлайн"));
+    EXPECT_EQ(lastEntry.getAction(), "Изменение дедлайна");
+    EXPECT_TRUE(lastEntry.getDetails().contains("дедлайн"));
 }
 
 TEST_F(TaskTest, HistoryNoChangeNoDuplicate) { // Одинаковые изменения не создают дубликатов в истории
@@ -293,9 +312,9 @@ TEST_F(TaskTest, JsonSerializationWithHistory) {
 
     // Проверяем первую запись истории
     QList<TaskHistoryEntry> loadedHistory = loaded.getHistory();
-    EXPECT_TRUE(loadedHistory[0].timestamp.isValid());
-    EXPECT_FALSE(loadedHistory[0].action.isEmpty());
-    EXPECT_FALSE(loadedHistory[0].details.isEmpty());
+    EXPECT_TRUE(loadedHistory[0].getTimestamp().isValid());
+    EXPECT_FALSE(loadedHistory[0].getAction().isEmpty());
+    EXPECT_FALSE(loadedHistory[0].getDetails().isEmpty());
 }
 
 TEST_F(TaskTest, JsonSerializationWithoutDeadline) {
@@ -0,0 +1,71 @@
+#include "animationclock.h"
+#include "effectsgovernor.h"
+
+AnimationClock* AnimationClock::instance() {
+    static AnimationClock clock;
+    return &clock;
+}
+
+AnimationClock::AnimationClock(QObject* parent) : QObject(parent) {
+    timer.setInterval(FrameIntervalMs);
+    timer.setTimerType(Qt::PreciseTimer); // Равномерные кадры вместо "грубых" 5% допусков
+    connect(&timer, &QTimer::timeout, this, &AnimationClock::tick);
+    elapsed.start();
+}
+
+void AnimationClock::registerClient(AnimationClient* client) {
+    if (!client || clients.contains(client)) {
+        return;
+    }
+    clients.append(client);
+
+    if (!timer.isActive()) {
+        lastTickMs = now(); // Первый шаг после простоя не должен "прыгать"
+        timer.start();
+    }
+}
+
+void AnimationClock::unregisterClient(AnimationClient* client) {
+    int index = clients.indexOf(client);
+    if (index < 0) {
+        return;
+    }
+
+    if (ticking) {
+        clients[index] = nullptr; // Уберем после прохода, чтобы не сдвигать индексы
+    } else {
+        clients.remove(index);
+        if (clients.isEmpty()) {
+            timer.stop(); // Нет анимаций - цикл событий не будится
+        }
+    }
+}
+
+int AnimationClock::clientCount() const {
+    return clients.size() - clients.count(nullptr);
+}
+
+void AnimationClock::tick() {
+    qint64 startNs = elapsed.nsecsElapsed();
+    qint64 nowMs = startNs / 1000000;
+    qreal deltaMs = nowMs - lastTickMs;
+    lastTickMs = nowMs;
+
+    ticking = true;
+    // Клиенты, зарегистрированные во время прохода, начнут со следующего тика
+    const int count = clients.size();
+    for (int i = 0; i < count; i++) {
+        if (clients[i]) {
+            clients[i]->advanceAnimation(nowMs, deltaMs);
+        }
+    }
+    ticking = false;
+
+    // Время обработки тика и фактический интервал кадра - для бюджета эффектов
+    EffectsGovernor::instance().recordFrame((elapsed.nsecsElapsed() - startNs) / 1e6, deltaMs);
+
+    clients.removeAll(nullptr);
+    if (clients.isEmpty()) {
+        timer.stop();
+    }
+}
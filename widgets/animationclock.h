@@ -0,0 +1,47 @@
+#ifndef ANIMATIONCLOCK_H
+#define ANIMATIONCLOCK_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+
+// Клиент общих часов анимации: получает время кадра и шаг с прошлого кадра
+class AnimationClient {
+public:
+    virtual ~AnimationClient() = default;
+    virtual void advanceAnimation(qint64 nowMs, qreal deltaMs) = 0;
+};
+
+// Общие часы анимации: один таймер на все карточки вместо таймера и QPropertyAnimation
+// в каждой. За тик все зарегистрированные клиенты продвигаются одним проходом,
+// каждый вызывает update() не больше одного раза за кадр.
+class AnimationClock : public QObject {
+    Q_OBJECT
+
+public:
+    static AnimationClock* instance();
+
+    static constexpr int FrameIntervalMs = 16; // ~60 кадров в секунду
+
+    void registerClient(AnimationClient* client);   // Повторная регистрация игнорируется
+    void unregisterClient(AnimationClient* client); // Безопасно вызывать во время тика
+    bool isRegistered(AnimationClient* client) const { return clients.contains(client); }
+
+    qint64 now() const { return elapsed.elapsed(); } // Время часов в мс (общая фаза для всех клиентов)
+    int clientCount() const;
+
+private slots:
+    void tick();
+
+private:
+    explicit AnimationClock(QObject* parent = nullptr);
+
+    QTimer timer;
+    QElapsedTimer elapsed;
+    qint64 lastTickMs = 0;
+    QVector<AnimationClient*> clients; // nullptr - клиент снят во время тика, убирается после прохода
+    bool ticking = false;
+};
+
+#endif // ANIMATIONCLOCK_H
@@ -0,0 +1,83 @@
+#include "cardstyle.h"
+#include <QLinearGradient>
+
+CardUrgency cardUrgency(const Task& task) {
+    return cardUrgency(task, QDateTime::currentDateTime());
+}
+
+CardUrgency cardUrgency(const Task& task, const QDateTime& now) {
+    if (task.getStatus() == TaskStatus::Done) {
+        return CardUrgency::Done;
+    }
+    if (!task.hasDeadline()) {
+        return CardUrgency::None;
+    }
+
+    int days = task.daysUntilDeadline(now);
+    if (task.isOverdue(now)) return CardUrgency::Overdue;
+    if (days == 0) return CardUrgency::Today;
+    if (days == 1) return CardUrgency::Tomorrow;
+    if (days <= 3) return CardUrgency::Soon;
+    return CardUrgency::None;
+}
+
+// Те же цвета, что у TaskCard при нулевой интенсивности свечения
+CardColors cardColors(CardUrgency urgency) {
+    switch (urgency) {
+    case CardUrgency::Overdue:
+        return {QColor(255, 200, 200), QColor("#5D0000"), QColor("#FF8A80")};
+    case CardUrgency::Today:
+        return {QColor(255, 220, 180), QColor("#E65100"), QColor("#FFAB91")};
+    case CardUrgency::Tomorrow:
+        return {QColor(255, 230, 200), QColor("#EF6C00"), QColor("#FFCC80")};
+    case CardUrgency::Soon:
+        return {QColor(255, 240, 210), QColor("#F57C00"), QColor("#FFE082")};
+    case CardUrgency::Done:
+        return {QColor("#E8F5E9"), QColor("#1B5E20"), QColor("#A5D6A7")};
+    case CardUrgency::None:
+    default:
+        return {QColor("#FFF3E0"), QColor("#333333"), QColor("#FFE0B2")};
+    }
+}
+
+QBrush cardBackground(CardUrgency urgency, qreal glowIntensity) {
+    switch (urgency) {
+    case CardUrgency::Overdue: {
+        // Красноватый диагональный градиент
+        int intensity = int(glowIntensity * 80);
+        QLinearGradient gradient(0, 0, 1, 1);
+        gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+        gradient.setColorAt(0, QColor(255, 200 + intensity / 2, 200 + intensity / 2));
+        gradient.setColorAt(0.5, QColor(255, 180 + intensity / 2, 180 + intensity / 2));
+        gradient.setColorAt(1, QColor(255, 200 + intensity / 2, 200 + intensity / 2));
+        return QBrush(gradient);
+    }
+    case CardUrgency::Today: {
+        // Оранжевый вертикальный градиент
+        int intensity = int(glowIntensity * 60);
+        QLinearGradient gradient(0, 0, 0, 1);
+        gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+        gradient.setColorAt(0, QColor(255, 220 + intensity / 2, 180));
+        gradient.setColorAt(1, QColor(255, 200 + intensity / 2, 200));
+        return QBrush(gradient);
+    }
+    case CardUrgency::Tomorrow: {
+        // Светло-оранжевый вертикальный градиент
+        int intensity = int(glowIntensity * 40);
+        QLinearGradient gradient(0, 0, 0, 1);
+        gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+        gradient.setColorAt(0, QColor(255, 230 + intensity / 2, 200));
+        gradient.setColorAt(1, QColor(255, 220 + intensity / 2, 210));
+        return QBrush(gradient);
+    }
+    case CardUrgency::Soon: {
+        // Желтоватый без градиента
+        int intensity = int(glowIntensity * 30);
+        return QBrush(QColor(255, 240 + intensity / 3, 210));
+    }
+    case CardUrgency::Done:
+    case CardUrgency::None:
+    default:
+        return QBrush(cardColors(urgency).background);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef CARDSTYLE_H
+#define CARDSTYLE_H
+
+#include <QColor>
+#include <QBrush>
+#include "../models/task.h"
+
+// Уровень срочности карточки (определяет цвета и визуальные эффекты)
+enum class CardUrgency {
+    None,     // Нет дедлайна или больше 3 дней
+    Soon,     // 2-3 дня
+    Tomorrow, // Завтра
+    Today,    // Сегодня
+    Overdue,  // Просрочена
+    Done      // Завершена
+};
+
+// Базовые цвета карточки без учета свечения
+struct CardColors {
+    QColor background;
+    QColor text;
+    QColor border;
+};
+
+CardUrgency cardUrgency(const Task& task);
+CardUrgency cardUrgency(const Task& task, const QDateTime& now); // Время задает вызывающий
+CardColors cardColors(CardUrgency urgency);
+
+// Фон карточки с учетом свечения (0..1): градиент в координатах карточки,
+// числа те же, что раньше подставлялись в qlineargradient таблицы стилей
+QBrush cardBackground(CardUrgency urgency, qreal glowIntensity);
+
+#endif // CARDSTYLE_H
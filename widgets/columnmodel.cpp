@@ -0,0 +1,125 @@
+#include "columnmodel.h"
+#include <QMimeData>
+#include <algorithm>
+
+ColumnModel::ColumnModel(Board* board, TaskStatus status, QObject* parent)
+    : QAbstractListModel(parent), board(board), status(status) {
+}
+
+void ColumnModel::insertTask(int row, Task* task) {
+    row = qBound(0, row, rows.size());
+    beginInsertRows(QModelIndex(), row, row);
+    rows.insert(row, Row{task->boardSequence(), task->getId(), board->getTaskHandle(task->getId())});
+    sequences.insert(task->getId(), task->boardSequence());
+    endInsertRows();
+}
+
+void ColumnModel::removeTask(TaskId taskId) {
+    int row = rowOf(taskId);
+    if (row < 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    rows.remove(row);
+    sequences.remove(taskId);
+    endRemoveRows();
+}
+
+void ColumnModel::updateTask(TaskId taskId) {
+    int row = rowOf(taskId);
+    if (row >= 0) {
+        QModelIndex changed = index(row);
+        emit dataChanged(changed, changed); // Делегат перерисует только эту строку
+    }
+}
+
+void ColumnModel::resetTasks(const Filter& filter) {
+    beginResetModel();
+    rows.clear();
+    sequences.clear();
+    const TaskSet& tasks = board->tasksWithStatus(status);
+    rows.reserve(tasks.size());
+    for (Task* task : tasks) {
+        if (filter(*task)) {
+            rows.append(Row{task->boardSequence(), task->getId(), board->getTaskHandle(task->getId())});
+            sequences.insert(task->getId(), task->boardSequence());
+        }
+    }
+    endResetModel();
+}
+
+void ColumnModel::clear() {
+    if (rows.isEmpty()) {
+        return;
+    }
+    beginResetModel();
+    rows.clear();
+    sequences.clear();
+    endResetModel();
+}
+
+int ColumnModel::rowOf(TaskId taskId) const {
+    auto it = sequences.constFind(taskId);
+    if (it == sequences.constEnd()) {
+        return -1;
+    }
+    auto row = std::lower_bound(rows.begin(), rows.end(), *it, [](const Row& r, quint64 sequence) {
+        return r.sequence < sequence;
+    });
+    return row != rows.end() && row->taskId == taskId ? int(row - rows.begin()) : -1;
+}
+
+Task* ColumnModel::taskAt(int row) const {
+    if (row < 0 || row >= rows.size()) {
+        return nullptr;
+    }
+    return board->resolveTask(rows[row].handle);
+}
+
+int ColumnModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0; // Плоский список
+    }
+    return rows.size();
+}
+
+QVariant ColumnModel::data(const QModelIndex& index, int role) const {
+    Task* task = taskAt(index.row());
+    if (!task) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return task->getTitle();
+    case TaskIdRole:
+        return task->getId();
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags ColumnModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+}
+
+QStringList ColumnModel::mimeTypes() const {
+    return QStringList() << "text/plain";
+}
+
+QMimeData* ColumnModel::mimeData(const QModelIndexList& indexes) const {
+    if (indexes.isEmpty()) {
+        return nullptr;
+    }
+    Task* task = taskAt(indexes.first().row());
+    if (!task) {
+        return nullptr;
+    }
+
+    QMimeData* mimeData = new QMimeData;
+    mimeData->setText(QString::number(task->getId())); // Колонка-получатель читает ID из текста
+    return mimeData;
+}
@@ -0,0 +1,65 @@
+#ifndef COLUMNMODEL_H
+#define COLUMNMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
+#include <functional>
+#include "../models/board.h"
+
+// Модель одной колонки поверх Board для виртуализированного режима:
+// хранит только дескрипторы задач колонки, данные читаются из доски при отрисовке.
+// Строки меняются операциями сверки (BoardReconciler), как карточки в обычном режиме:
+// представление сохраняет прокрутку и выделение, перерисовываются только затронутые строки.
+// Строки идут в порядке доски (по порядковому номеру задачи), поэтому строка задачи
+// находится двоичным поиском. Много операций сразу (загрузка, смена фильтра) - одним сбросом
+class ColumnModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Roles {
+        TaskIdRole = Qt::UserRole + 1 // ID задачи в строке
+    };
+
+    using Filter = std::function<bool(const Task&)>;
+
+    // Операций на колонку, после которых строки перечитываются одним сбросом, а не по одной
+    static constexpr int ResetOperations = 64;
+
+    explicit ColumnModel(Board* board, TaskStatus status, QObject* parent = nullptr);
+
+    // Операции сверки: вставка на позицию, удаление по ID (задача может быть уже удалена с доски),
+    // изменение полей задачи. Поиск строки - O(log n)
+    void insertTask(int row, Task* task);
+    void removeTask(TaskId taskId);
+    void updateTask(TaskId taskId);
+    // Сброс: строки - все задачи колонки, прошедшие фильтр (когда операций слишком много)
+    void resetTasks(const Filter& filter);
+    bool prefersReset(int operations) const { return operations > ResetOperations || operations * 4 > rows.size(); }
+    void clear(); // Убрать все строки (выход из виртуализированного режима)
+    Task* taskAt(int row) const; // nullptr, если задача уже удалена
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    // Перетаскивание: в MIME передается ID задачи, как у TaskCard
+    QStringList mimeTypes() const override;
+    QMimeData* mimeData(const QModelIndexList& indexes) const override;
+    Qt::DropActions supportedDragActions() const override { return Qt::MoveAction; }
+
+private:
+    Board* board;
+    TaskStatus status;
+    struct Row {
+        quint64 sequence; // Порядковый номер задачи на доске: по нему строки упорядочены
+        TaskId taskId;
+        TaskHandle handle;
+    };
+    QVector<Row> rows;
+    QHash<TaskId, quint64> sequences; // Порядковый номер показанной задачи (сама она может быть уже удалена)
+
+    int rowOf(TaskId taskId) const; // -1, если строки нет
+};
+
+#endif // COLUMNMODEL_H
@@ -1,6 +1,7 @@
 #include "columnwidget.h"
 #include <QFont> // Для настройки шрифта заголовка
 #include <QMimeData> // Для работы с данными при перетаскивании (drag-and-drop)
+#include <QScrollBar>
 
 ColumnWidget::ColumnWidget(const QString& title, const QString& color, TaskStatus status, QWidget* parent)
     : QWidget(parent), columnTitle(title), columnStatus(status) {
@@ -37,6 +38,24 @@ ColumnWidget::ColumnWidget(const QString& title, const QString& color, TaskStatu
     scrollArea->setWidget(cardsContainer);
     mainLayout->addWidget(scrollArea);
 
+    // Видимость карточек меняется при прокрутке и при изменении размеров области или списка карточек
+    connect(scrollArea->verticalScrollBar(), &QScrollBar::valueChanged, this, &ColumnWidget::updateCardExposure);
+    scrollArea->viewport()->installEventFilter(this);
+    cardsContainer->installEventFilter(this);
+
+    // Список для виртуализированного режима (скрыт, пока режим не включен)
+    listView = new QListView(this);
+    listView->setUniformItemSizes(true); // Высота строк одинакова - раскладка не зависит от числа задач
+    listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    listView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    listView->setSelectionMode(QAbstractItemView::SingleSelection); // Без выделения QListView не начинает drag
+    listView->setDragDropMode(QAbstractItemView::DragOnly); // Бросание обрабатывает сама колонка
+    listView->setDefaultDropAction(Qt::MoveAction);
+    listView->setStyleSheet("QListView { border: none; background-color: #f5f5f5; }"
+                            "QListView::item:selected { background: transparent; }");
+    listView->hide();
+    mainLayout->addWidget(listView);
+
     // Адаптивные столбцы - могут расширяться
     setMinimumWidth(250);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding); // Может растягиваться
@@ -47,6 +66,45 @@ void ColumnWidget::addTaskCard(TaskCard* card) {
     cardsLayout->addWidget(card);
 }
 
+void ColumnWidget::insertTaskCard(int index, TaskCard* card) {
+    cardsLayout->insertWidget(index, card); // Виджет переносится в контейнер этой колонки
+    card->show();
+}
+
+void ColumnWidget::removeTaskCard(TaskCard* card) {
+    cardsLayout->removeWidget(card);
+    card->hide(); // Пока карточка не вставлена в другую колонку или не удалена
+}
+
+void ColumnWidget::setVirtualModel(QAbstractItemModel* model, QAbstractItemDelegate* delegate) {
+    listView->setModel(model);
+    listView->setItemDelegate(delegate);
+}
+
+void ColumnWidget::setVirtualized(bool enabled) {
+    scrollArea->setVisible(!enabled);
+    listView->setVisible(enabled);
+}
+
+bool ColumnWidget::eventFilter(QObject* watched, QEvent* event) {
+    if ((watched == scrollArea->viewport() || watched == cardsContainer) && event->type() == QEvent::Resize) {
+        updateCardExposure();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void ColumnWidget::updateCardExposure() {
+    // Видимая часть контейнера карточек в его координатах
+    QRect visibleArea(-cardsContainer->pos(), scrollArea->viewport()->size());
+
+    for (int i = 0; i < cardsLayout->count(); i++) {
+        TaskCard* card = qobject_cast<TaskCard*>(cardsLayout->itemAt(i)->widget());
+        if (card) {
+            card->setExposed(card->geometry().intersects(visibleArea));
+        }
+    }
+}
+
 void ColumnWidget::clearTasks() {
     while (cardsLayout->count() > 0) { // Пока есть элементы в layout
         QLayoutItem* item = cardsLayout->takeAt(0); // Берем первый элемент
@@ -74,7 +132,7 @@ void ColumnWidget::dragMoveEvent(QDragMoveEvent* event) {
 void ColumnWidget::dropEvent(QDropEvent* event) {
     if (event->mimeData()->hasText()) {
         // Текст содержит ID задачи
-        int taskId = event->mimeData()->text().toInt();
+        TaskId taskId = event->mimeData()->text().toLongLong();
         emit taskDropped(taskId, columnStatus); // Испускаем сигнал с ID задачи и новым статусом
         event->acceptProposedAction();
     }
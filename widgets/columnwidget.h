@@ -5,6 +5,7 @@
 #include <QVBoxLayout>  // Вертикальное расположение элементов
 #include <QLabel>  // Текстовая метка для заголовка
 #include <QScrollArea> // Прокручиваемая область для карточек
+#include <QListView> // Виртуализированный список для больших досок
 #include <QDragEnterEvent>
 #include <QDropEvent>
 #include "taskcard.h"
@@ -19,14 +20,23 @@ public:
 
     // Управление карточками
     void addTaskCard(TaskCard* card);
+    void insertTaskCard(int index, TaskCard* card); // Вставка на позицию (для точечного обновления)
+    void removeTaskCard(TaskCard* card); // Снять карточку с колонки без удаления
     void clearTasks();
     TaskStatus getStatus() const { return columnStatus; }
 
+    // Виртуализированный режим: QListView с делегатом рисует только видимые карточки
+    void setVirtualModel(QAbstractItemModel* model, QAbstractItemDelegate* delegate);
+    void setVirtualized(bool enabled);
+    bool isVirtualized() const { return listView->isVisibleTo(this); }
+
 signals:
     // Сигнал при перетаскивании задачи в столбец
-    void taskDropped(int taskId, TaskStatus newStatus);
+    void taskDropped(TaskId taskId, TaskStatus newStatus);
 
 protected:
+    bool eventFilter(QObject* watched, QEvent* event) override; // Изменения размеров области карточек
+
     // Обработка событий drag-and-drop
     void dragEnterEvent(QDragEnterEvent* event) override;
     void dragMoveEvent(QDragMoveEvent* event) override;
@@ -39,6 +49,10 @@ private:
     QVBoxLayout* cardsLayout; // Layout для расположения карточек (вертикальный)
     QWidget* cardsContainer;
     QScrollArea* scrollArea; // Прокручиваемая область для карточек
+    QListView* listView; // Используется вместо scrollArea в виртуализированном режиме
+
+    // Сообщить карточкам, видны ли они в области прокрутки (невидимые останавливают эффекты)
+    void updateCardExposure();
 };
 
 #endif // COLUMNWIDGET_H
\ No newline at end of file
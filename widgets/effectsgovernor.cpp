@@ -0,0 +1,116 @@
+#include "effectsgovernor.h"
+
+namespace {
+
+const int ParticlesPerLevel = 40; // Как у прежней генерации: intensity * 40
+
+} // namespace
+
+EffectsGovernor::EffectsGovernor() : EffectsGovernor(Settings()) {
+}
+
+EffectsGovernor::EffectsGovernor(const Settings& settings)
+    : settings(settings), averageInterval(settings.frameIntervalMs) {
+    reallocate();
+}
+
+EffectsGovernor& EffectsGovernor::instance() {
+    static EffectsGovernor governor;
+    return governor;
+}
+
+void EffectsGovernor::recordFrame(qreal workMs, qreal intervalMs) {
+    // Экспоненциальное сглаживание: единичный долгий кадр не меняет уровень
+    const qreal alpha = 0.1;
+    averageWork += (workMs - averageWork) * alpha;
+    averageInterval += (intervalMs - averageInterval) * alpha;
+
+    bool heavy = averageWork > settings.workBudgetMs
+              || averageInterval > settings.frameIntervalMs * 1.5; // Цикл событий не успевает
+    bool light = averageWork < settings.workBudgetMs * 0.5
+              && averageInterval < settings.frameIntervalMs * 1.2;
+
+    heavyFrames = heavy ? heavyFrames + 1 : 0;
+    lightFrames = light ? lightFrames + 1 : 0;
+
+    if (heavyFrames >= settings.framesToDegrade && currentLevel != GlowOnly) {
+        setLevel(Level(currentLevel + 1));
+    } else if (lightFrames >= settings.framesToRecover && currentLevel != Full) {
+        setLevel(Level(currentLevel - 1));
+    }
+}
+
+void EffectsGovernor::setLevel(Level level) {
+    heavyFrames = 0;
+    lightFrames = 0;
+    if (level == currentLevel) {
+        return;
+    }
+    currentLevel = level;
+    reallocate();
+}
+
+void EffectsGovernor::setDemand(const void* card, int intensity) {
+    intensity = qBound(0, intensity, 4);
+    auto it = demands.find(card);
+    int previous = it == demands.end() ? 0 : it.value();
+    if (previous == intensity) {
+        return;
+    }
+
+    if (previous > 0) {
+        demandCount[previous]--;
+    }
+    if (intensity > 0) {
+        demandCount[intensity]++;
+        demands.insert(card, intensity);
+    } else {
+        demands.erase(it);
+    }
+    reallocate();
+}
+
+int EffectsGovernor::particleAllowance(int intensity) const {
+    return allowance[qBound(0, intensity, 4)];
+}
+
+void EffectsGovernor::reallocate() {
+    qreal factor = 1.0;
+    int lowestLevel = 1; // Ниже этого уровня срочности частиц нет
+    switch (currentLevel) {
+    case Full:      factor = 1.0;  lowestLevel = 1; break;
+    case Reduced:   factor = 0.5;  lowestLevel = 1; break;
+    case Essential: factor = 0.25; lowestLevel = 3; break;
+    case GlowOnly:  factor = 0.0;  lowestLevel = 5; break;
+    }
+
+    // Раздаем бюджет от самых срочных к менее срочным
+    int remaining = settings.particleBudget;
+    for (int level = 4; level >= 1; level--) {
+        int wanted = level >= lowestLevel ? int(level * ParticlesPerLevel * factor) : 0;
+        int cards = demandCount[level];
+        if (cards > 0 && wanted * cards > remaining) {
+            wanted = remaining / cards; // Поровну между карточками уровня, остальным уровням не остается
+        }
+        if (allowance[level] != wanted) {
+            // Новая версия только у уровня, чья доля изменилась: карточки других уровней не перегенерируют частицы
+            levelVersion[level] = ++version;
+        }
+        allowance[level] = wanted;
+        remaining -= wanted * cards;
+    }
+}
+
+EffectsGovernor::Diagnostics EffectsGovernor::diagnostics() const {
+    Diagnostics d;
+    d.level = currentLevel;
+    d.averageIntervalMs = averageInterval;
+    d.averageWorkMs = averageWork;
+    d.particleBudget = settings.particleBudget;
+    d.particlesAllocated = 0;
+    d.cardsWithParticles = demands.size();
+    for (int level = 1; level <= 4; level++) {
+        d.particlesAllocated += allowance[level] * demandCount[level];
+    }
+    return d;
+}
@@ -0,0 +1,79 @@
+#ifndef EFFECTSGOVERNOR_H
+#define EFFECTSGOVERNOR_H
+
+#include <QHash>
+#include <QtGlobal>
+
+// Общий бюджет визуальных эффектов карточек.
+// Часы анимации сообщают время каждого кадра; при перегрузке качество понижается
+// ступенями (меньше частиц, реже шаг частиц, частицы только у самых срочных,
+// только свечение), при устойчиво легких кадрах - возвращается обратно.
+// Частицы распределяются из общего лимита по приоритету срочности: сначала просроченные.
+class EffectsGovernor {
+public:
+    enum Level {
+        Full,      // Все эффекты
+        Reduced,   // Половина частиц, шаг частиц через кадр
+        Essential, // Четверть частиц и только у задач "сегодня" и просроченных
+        GlowOnly   // Без частиц
+    };
+
+    struct Settings {
+        qreal frameIntervalMs = 16.0; // Ожидаемый интервал кадра часов
+        qreal workBudgetMs = 6.0;     // Допустимое время обработки тика
+        int particleBudget = 6000;    // Общий лимит частиц на все карточки
+        int framesToDegrade = 30;     // Подряд тяжелых кадров до понижения уровня
+        int framesToRecover = 180;    // Подряд легких кадров до повышения уровня
+    };
+
+    struct Diagnostics {
+        Level level;
+        qreal averageIntervalMs; // Сглаженный фактический интервал между кадрами
+        qreal averageWorkMs;     // Сглаженное время обработки тика
+        int particleBudget;
+        int particlesAllocated;  // Сумма разрешенных частиц по всем карточкам
+        int cardsWithParticles;  // Карточки, запросившие частицы
+    };
+
+    EffectsGovernor();
+    explicit EffectsGovernor(const Settings& settings);
+
+    static EffectsGovernor& instance(); // Общий для всех карточек приложения
+
+    // Замер кадра: время работы тика и фактический интервал с прошлого тика
+    void recordFrame(qreal workMs, qreal intervalMs);
+    Level level() const { return currentLevel; }
+    void setLevel(Level level); // Принудительно (например, для диагностики)
+    int particleStride() const { return currentLevel == Full ? 1 : 2; } // Шаг частиц раз в N кадров
+
+    // Запрос частиц карточкой: intensity 1-4 (0 - снять запрос)
+    void setDemand(const void* card, int intensity);
+    void removeDemand(const void* card) { setDemand(card, 0); }
+    int particleAllowance(int intensity) const; // Сколько частиц разрешено одной карточке этого уровня
+
+    // Версия доли уровня intensity: меняется, только когда меняется particleAllowance(intensity).
+    // Карточка сравнивает со своей и перегенерирует частицы. Версии уникальны на все уровни;
+    // без аргумента - последняя выданная (меняется при изменении доли любого уровня)
+    quint64 allocationVersion(int intensity) const { return levelVersion[qBound(0, intensity, 4)]; }
+    quint64 allocationVersion() const { return version; }
+
+    Diagnostics diagnostics() const;
+
+private:
+    Settings settings;
+    Level currentLevel = Full;
+    qreal averageInterval;
+    qreal averageWork = 0;
+    int heavyFrames = 0;
+    int lightFrames = 0;
+
+    QHash<const void*, int> demands; // Карточка -> уровень срочности
+    int demandCount[5] = {0, 0, 0, 0, 0}; // Число карточек по уровням
+    int allowance[5] = {0, 0, 0, 0, 0};   // Частиц на карточку по уровням
+    quint64 levelVersion[5] = {0, 0, 0, 0, 0};
+    quint64 version = 1;
+
+    void reallocate();
+};
+
+#endif // EFFECTSGOVERNOR_H
@@ -0,0 +1,64 @@
+#include "particleatlas.h"
+#include "particlesystem.h"
+#include <QPainter>
+#include <QRadialGradient>
+#include <QtMath>
+
+QHash<quint64, ParticleAtlas::Sheet>& ParticleAtlas::cache() {
+    static QHash<quint64, Sheet> sheets;
+    return sheets;
+}
+
+const ParticleAtlas::Sheet& ParticleAtlas::sheet(int intensity, qreal devicePixelRatio) {
+    // Ключ: уровень + плотность пикселей с точностью до сотых
+    quint64 key = (quint64(intensity) << 32) | quint32(qRound(devicePixelRatio * 100));
+    QHash<quint64, Sheet>& sheets = cache();
+    auto it = sheets.find(key);
+    if (it == sheets.end()) {
+        it = sheets.insert(key, render(intensity, devicePixelRatio));
+    }
+    return *it;
+}
+
+void ParticleAtlas::clear() {
+    cache().clear();
+}
+
+ParticleAtlas::Sheet ParticleAtlas::render(int intensity, qreal devicePixelRatio) {
+    // Ячейка вмещает самую крупную точку с запасом в пиксель на сглаживание
+    const qreal maxRadius = ParticleSystem::spriteRadius(ParticleSystem::SizeBuckets - 1);
+    const int cell = qCeil(maxRadius * 2 * devicePixelRatio) + 2;
+
+    Sheet sheet;
+    sheet.scale = 1.0 / devicePixelRatio;
+    sheet.pixmap = QPixmap(cell * ParticleSystem::SizeBuckets, cell * ParticleSystem::ColorBuckets);
+    sheet.pixmap.fill(Qt::transparent);
+
+    QPainter painter(&sheet.pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+
+    for (int sprite = 0; sprite < ParticleSystem::SpriteCount; sprite++) {
+        int column = sprite % ParticleSystem::SizeBuckets;
+        int row = sprite / ParticleSystem::SizeBuckets;
+        QRectF source(column * cell, row * cell, cell, cell);
+        QPointF center = source.center();
+        qreal radius = ParticleSystem::spriteRadius(sprite) * devicePixelRatio;
+
+        // Тот же градиент, что рисовался для каждой частицы: цвет -> 30% -> прозрачный
+        QColor color(ParticleSystem::spriteColor(intensity, sprite));
+        QRadialGradient gradient(center, radius);
+        gradient.setColorAt(0, color);
+        QColor fadeColor = color;
+        fadeColor.setAlphaF(0.3);
+        gradient.setColorAt(0.6, fadeColor);
+        fadeColor.setAlphaF(0);
+        gradient.setColorAt(1, fadeColor);
+
+        painter.setBrush(gradient);
+        painter.drawEllipse(center, radius, radius);
+        sheet.sources.append(source);
+    }
+
+    return sheet;
+}
@@ -0,0 +1,29 @@
+#ifndef PARTICLEATLAS_H
+#define PARTICLEATLAS_H
+
+#include <QPixmap>
+#include <QRectF>
+#include <QHash>
+#include <QVector>
+
+// Атлас заранее отрисованных мягких точек для частиц карточек.
+// Один лист на уровень срочности и плотность пикселей экрана: ParticleSystem::SpriteCount
+// ячеек (цвет x размер). Карточка рисует частицы через drawPixmapFragments - по одному
+// копированию текстуры на частицу вместо радиального градиента и сглаженного эллипса.
+class ParticleAtlas {
+public:
+    struct Sheet {
+        QPixmap pixmap;
+        QVector<QRectF> sources; // Ячейка спрайта в пикселях листа
+        qreal scale = 1.0;       // Множитель для фрагмента: пиксели листа -> логические пиксели
+    };
+
+    static const Sheet& sheet(int intensity, qreal devicePixelRatio);
+    static void clear(); // Например, при смене экрана с другой плотностью пикселей
+
+private:
+    static Sheet render(int intensity, qreal devicePixelRatio);
+    static QHash<quint64, Sheet>& cache();
+};
+
+#endif // PARTICLEATLAS_H
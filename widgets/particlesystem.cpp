@@ -0,0 +1,173 @@
+#include "particlesystem.h"
+
+namespace {
+
+constexpr float UnitScale = 1.0f / 16777216.0f; // 24 старших бита -> [0, 1)
+
+inline quint32 xorshift(quint32 s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// Диапазоны цветов частиц по уровням срочности (как у прежней генерации): от и до
+struct Palette {
+    int r0, g0, b0;
+    int r1, g1, b1;
+};
+
+const Palette palettes[] = {
+    {255, 120, 20, 255, 219, 59}, // 1: дедлайн через 2-3 дня
+    {255, 140, 0, 255, 254, 49},  // 2: дедлайн завтра
+    {255, 40, 0, 255, 119, 0},    // 3: дедлайн сегодня
+    {80, 20, 10, 119, 39, 24}     // 4: просрочено - темные "угли"
+};
+
+} // namespace
+
+QRgb ParticleSystem::spriteColor(int intensity, int sprite) {
+    const Palette& p = palettes[qBound(1, intensity, 4) - 1];
+    float t = (sprite / SizeBuckets + 0.5f) / ColorBuckets;
+    return qRgb(p.r0 + int((p.r1 - p.r0) * t),
+                p.g0 + int((p.g1 - p.g0) * t),
+                p.b0 + int((p.b1 - p.b0) * t));
+}
+
+float ParticleSystem::spriteRadius(int sprite) {
+    // Размеры частиц 3..7 делятся на равные корзины
+    return (3.0f + (sprite % SizeBuckets + 0.5f) * (4.0f / SizeBuckets)) * 1.5f;
+}
+
+ParticleSystem::ParticleSystem(quint32 seed) : random(seed) {
+}
+
+void ParticleSystem::clear() {
+    xs.clear();
+    ys.clear();
+    opacities.clear();
+    sizes.clear();
+    velocities.clear();
+    seeds.clear();
+    sprites.clear();
+    level = 0;
+}
+
+// Попадает ли точка в скругленный угол карточки (сравнение квадратов расстояний, без sqrt)
+bool ParticleSystem::inCorner(float x, float y, float width, float height) const {
+    const float r = CornerRadius;
+    const float r2 = r * r;
+    auto withinRadius = [r2](float dx, float dy) { return dx * dx + dy * dy < r2; };
+
+    bool left = x < r;
+    bool right = x > width - r;
+    bool top = y < r;
+    bool bottom = y > height - r;
+
+    return (left && top && withinRadius(x, y))
+        || (right && top && withinRadius(x - width, y))
+        || (left && bottom && withinRadius(x, y - height))
+        || (right && bottom && withinRadius(x - width, y - height));
+}
+
+void ParticleSystem::generate(int intensity, float width, float height, int count) {
+    clear();
+    if (count < 0) {
+        count = intensity * 40;
+    }
+    if (intensity <= 0 || count == 0 || width <= 0 || height <= 0) {
+        return;
+    }
+
+    level = qBound(1, intensity, 4);
+    xs.reserve(count);
+    ys.reserve(count);
+    opacities.reserve(count);
+    sizes.reserve(count);
+    velocities.reserve(count);
+    seeds.reserve(count);
+    sprites.reserve(count);
+
+    // Ограничиваем область генерации нижними 30% карточки
+    const float areaHeight = height * 0.3f;
+    const float areaTop = height - areaHeight;
+
+    for (int i = 0; i < count; i++) {
+        float x = 0;
+        float y = 0;
+        bool valid = false;
+        for (int attempt = 0; attempt < 10 && !valid; attempt++) {
+            x = random.uniform() * width;
+            y = areaTop + random.uniform() * areaHeight;
+            valid = !inCorner(x, y, width, height);
+        }
+        if (!valid) continue; // Пропускаем эту частицу
+
+        float opacity = 0.4f + random.uniform() * 0.6f;
+        float size = 3.0f + random.uniform() * 4.0f;
+        float velocity = 0.3f + random.uniform() * 1.2f;
+
+        // Просроченные: крупные медленные тусклые частицы
+        if (level == 4) {
+            size = 4.0f + random.uniform() * 3.0f;
+            velocity = 0.1f + random.uniform() * 0.3f;
+            opacity = 0.3f + random.uniform() * 0.5f;
+        }
+
+        // Цвет - случайная корзина палитры уровня, размер - корзина по размеру
+        int colorBucket = random.bounded(0, ColorBuckets);
+        int sizeBucket = qBound(0, int((size - 3.0f) * SizeBuckets / 4.0f), SizeBuckets - 1);
+
+        xs.append(x);
+        ys.append(y);
+        opacities.append(opacity);
+        sizes.append(size);
+        velocities.append(velocity);
+        seeds.append(random.next() | 1u); // Нулевое состояние xorshift вырождено
+        sprites.append(quint8(colorBucket * SizeBuckets + sizeBucket));
+    }
+}
+
+void ParticleSystem::step(float step, float width, float height) {
+    const int n = xs.size();
+    float* __restrict px = xs.data();
+    float* __restrict py = ys.data();
+    float* __restrict po = opacities.data();
+    float* __restrict pv = velocities.data();
+    quint32* __restrict ps = seeds.data();
+
+    // Зона появления по X - без нижних углов
+    const float spawnMin = CornerRadius + 5.0f;
+    const float spawnMax = width - CornerRadius - 5.0f;
+    const float spawnY = height + 5.0f; // Сразу под карточкой
+    const float jitter = 0.5f * step;
+    const float fade = 0.015f * step; // Постепенное исчезновение
+
+    // Цикл без ветвлений: новое и "возрожденное" значения считаются всегда и смешиваются
+    // маской 0/1. Тернарный оператор с вычислениями в ветке компилятор превращает
+    // в переход и не векторизует (без -ffast-math), смешивание - векторизует.
+    for (int i = 0; i < n; i++) {
+        quint32 s = xorshift(ps[i]);
+        ps[i] = s;
+        float r0 = int(s >> 8) * UnitScale;
+        float r1 = int((s * 747796405u) >> 8) * UnitScale;
+        float r2 = int((s * 2891336453u) >> 8) * UnitScale;
+        float r3 = int((s * 1103515245u) >> 8) * UnitScale;
+
+        float nx = px[i] + (r0 - 0.5f) * jitter;
+        float ny = py[i] - pv[i] * step;
+        float no = po[i] - fade;
+
+        bool dead = (ny < -10.0f) | (no <= 0.0f) | (nx < 0.0f) | (nx > width);
+
+        float sx = r1 * width;
+        sx = sx < CornerRadius ? spawnMin : sx;
+        sx = sx > width - CornerRadius ? spawnMax : sx;
+
+        float m = dead ? 1.0f : 0.0f;
+        px[i] = nx + m * (sx - nx);
+        py[i] = ny + m * (spawnY - ny);
+        po[i] = no + m * (0.6f + r2 * 0.4f - no);
+        pv[i] = pv[i] + m * (0.3f + r3 * 1.2f - pv[i]);
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <QVector>
+#include <QRgb>
+#include <QtGlobal>
+
+// Быстрый генератор xorshift32 для эффектов карточки: свой у каждой карточки,
+// без мьютекса QRandomGenerator::global()
+class FastRandom {
+public:
+    explicit FastRandom(quint32 seed = 0x9E3779B9u) : state(seed ? seed : 0x9E3779B9u) {}
+
+    quint32 next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    float uniform() { return (next() >> 8) * (1.0f / 16777216.0f); } // [0, 1)
+    int bounded(int low, int high) { return low + int(next() % quint32(high - low)); } // [low, high)
+
+private:
+    quint32 state;
+};
+
+// Частицы карточки в виде структуры массивов: каждое поле - отдельный массив float,
+// поэтому цикл обновления компилятор разворачивает в векторные инструкции.
+// Случайные числа в цикле берутся из собственного xorshift-состояния каждой частицы.
+class ParticleSystem {
+public:
+    static constexpr float CornerRadius = 12.0f;
+
+    // Спрайт частицы: корзина цвета (в палитре уровня срочности) x корзина размера.
+    // По номеру спрайта карточка берет заранее отрисованную точку из атласа.
+    static constexpr int ColorBuckets = 8;
+    static constexpr int SizeBuckets = 8;
+    static constexpr int SpriteCount = ColorBuckets * SizeBuckets;
+    static QRgb spriteColor(int intensity, int sprite);
+    static float spriteRadius(int sprite); // Радиус мягкой точки (1.5 размера частицы)
+
+    explicit ParticleSystem(quint32 seed = 0x9E3779B9u);
+
+    // Заполнить нижние 30% карточки частицами для уровня срочности 1-4
+    // (count < 0 - как раньше, intensity * 40; иначе столько, сколько разрешил бюджет эффектов)
+    void generate(int intensity, float width, float height, int count = -1);
+    // Сдвиг частиц на step прежних тиков (50 мс); вышедшие или погасшие появляются под карточкой
+    void step(float step, float width, float height);
+    void clear();
+
+    int size() const { return xs.size(); }
+    bool isEmpty() const { return xs.isEmpty(); }
+
+    const float* x() const { return xs.constData(); }
+    const float* y() const { return ys.constData(); }
+    const float* opacity() const { return opacities.constData(); }
+    const float* radius() const { return sizes.constData(); }
+    const quint8* sprite() const { return sprites.constData(); } // Цвет и размер, прозрачность в opacity()
+    int intensity() const { return level; }
+
+private:
+    QVector<float> xs;
+    QVector<float> ys;
+    QVector<float> opacities;
+    QVector<float> sizes;
+    QVector<float> velocities;
+    QVector<quint32> seeds; // Состояние генератора для каждой частицы
+    QVector<quint8> sprites;
+    FastRandom random;
+    int level = 0; // Уровень срочности, для которого сгенерированы частицы
+
+    bool inCorner(float x, float y, float width, float height) const;
+};
+
+#endif // PARTICLESYSTEM_H
@@ -117,7 +117,7 @@ void StartScreen::openFileDialog() {
         this, // Родительское окно
         "Открыть доску",
         currentPath, // Начальная директория
-        "JSON файлы (*.json);;Все файлы (*.*)"
+        "Доски (*.json *.sbb *.sbs);;JSON файлы (*.json);;Бинарный формат (*.sbb);;Сегментированный формат (*.sbs);;Все файлы (*.*)"
     );
 
      // Если пользователь выбрал файл
@@ -4,30 +4,32 @@
 #include <QMimeData> // Данные для drag-and-drop
 #include <QApplication> // Для определения дистанции начала перетаскивания
 #include <QDrag>
-#include <QRandomGenerator>
+#include <QRandomGenerator> // Начальное состояние генератора частиц карточки
 #include <QDebug> // Отладочный вывод
 #include <QPainterPath> // Сложные пути для рисования
+#include "particleatlas.h"
+#include "cardstyle.h"
+#include "effectsgovernor.h"
+#include <QtMath>
 
 TaskCard::TaskCard(Task* task, Board* board, QWidget* parent) // Конструктор карточки задачи
-    : QWidget(parent), task(task), board(board), m_glowIntensity(0.0), particleIntensity(0), lastDaysUntilDeadline(999) {
-
-    // КРИТИЧЕСКИ ВАЖНО для работы border-radius на QWidget!
-    setAttribute(Qt::WA_StyledBackground, true);
-
-    // Создание анимации свечения
-    glowAnimation = new QPropertyAnimation(this, "glowIntensity");
-    glowAnimation->setDuration(1500); // Длительность одного цикла: 1.5 секунды
-    glowAnimation->setLoopCount(-1); // Бесконечное повторение
-    glowAnimation->setEasingCurve(QEasingCurve::InOutSine);
-
-    particleTimer = new QTimer(this);
-    connect(particleTimer, &QTimer::timeout, this, &TaskCard::updateParticles);
+    : QWidget(parent), task(task), board(board),
+      glowActive(false), glowStartMs(0), glowDurationMs(1500), glowLow(0.0), glowHigh(0.5),
+      particles(QRandomGenerator::global()->generate()),
+      m_glowIntensity(0.0), particleIntensity(0), lastDaysUntilDeadline(999),
+      urgency(CardUrgency::None), styleApplied(false), exposed(true),
+      particleVersion(0), particleDeltaMs(0), particleTick(0) {
 
     setupUI(); // Настройка интерфейса
     updateDisplay();
     setAcceptDrops(false); // Карточка не принимает другие карточки
 }
 
+TaskCard::~TaskCard() {
+    AnimationClock::instance()->unregisterClient(this);
+    EffectsGovernor::instance().removeDemand(this);
+}
+
 // Настройка пользовательского интерфейса карточки
 void TaskCard::setupUI() {
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
@@ -113,10 +115,25 @@ void TaskCard::setupUI() {
     setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
 }
 
-// Интенсивности свечения
+// Интенсивности свечения: меняется только фон, поэтому достаточно перерисовки
 void TaskCard::setGlowIntensity(qreal intensity) {
+    if (qFuzzyCompare(m_glowIntensity + 1.0, intensity + 1.0)) {
+        return;
+    }
     m_glowIntensity = intensity;
-    updateCardColor();
+    update();
+}
+
+// Привязка карточки к другой задаче: эффекты старой задачи сбрасываются
+void TaskCard::rebind(Task* newTask) {
+    stopGlowAnimation();
+    stopParticles();
+    m_glowIntensity = 0.0;
+    lastDaysUntilDeadline = 999; // Частицы пересчитаются для новой задачи
+    dragStartPosition = QPoint();
+
+    task = newTask;
+    updateDisplay();
 }
 
 // Обновление отображения всех данных карточки
@@ -126,35 +143,19 @@ void TaskCard::updateDisplay() {
     // Название задачи
     titleLabel->setText(task->getTitle());
 
-    // Описание (макс 120 символов)
-    QString desc = task->getDescription();
+    // Описание (макс 120 символов); строка задачи не копируется, новая собирается только при обрезке
+    const QString& desc = task->getDescription();
     if (desc.isEmpty()) {
         descLabel->setText("Нет описания");
+    } else if (desc.length() > 120) {
+        descLabel->setText(desc.left(117) + "...");
     } else {
-        if (desc.length() > 120) {
-            desc = desc.left(117) + "...";
-        }
         descLabel->setText(desc);
     }
 
     // Дедлайн
     if (task->hasDeadline()) {
-        int days = task->daysUntilDeadline();
-        QString deadlineText;
-
-        if (task->isOverdue()) {
-            deadlineText = QString("🔥 Просрочено на %1 дн.").arg(-days);
-        } else if (days == 0) {
-            deadlineText = "🔥 Дедлайн сегодня!";
-        } else if (days == 1) {
-            deadlineText = "⚠️ Дедлайн завтра";
-        } else if (days <= 3) {
-            deadlineText = QString("📅 Дедлайн: %1 дн.").arg(days);
-        } else {
-            deadlineText = QString("📅 Дедлайн: %1 дн.").arg(days);
-        }
-
-        deadlineLabel->setText(deadlineText);
+        deadlineLabel->setText(deadlineText(*task));
         deadlineLabel->show();
     } else {
         deadlineLabel->hide();
@@ -175,81 +176,31 @@ void TaskCard::updateDisplay() {
     updateCardColor();
 }
 
+// Срочность карточки: запускает или останавливает эффекты и меняет стиль только при смене уровня.
+// Цвет фона со свечением рисуется в paintEvent, таблица стилей на каждом кадре не пересобирается.
 void TaskCard::updateCardColor() {
     if (!task) return;
 
-    QString bgColor = "#FFF3E0";
-    QString textColor = "#333";
-    QString borderColor = "#FFE0B2";
-    int days = 999;
+    const QDateTime now = QDateTime::currentDateTime(); // Одно время на уровень и число дней
+    CardUrgency newUrgency = cardUrgency(*task, now);
 
-    // Если есть дедлайн И задача не завершена - анализируем срочность
-    if (task->hasDeadline() && task->getStatus() != TaskStatus::Done) {
-        days = task->daysUntilDeadline();
+    // Если есть дедлайн И задача не завершена - эффекты по срочности
+    if (task->hasDeadline() && newUrgency != CardUrgency::Done) {
+        int days = task->daysUntilDeadline(now);
         int targetIntensity = 0; // Интенсивность эффектов (0-4)
 
-        if (task->isOverdue()) {
-            // Уровень 4: просроченные задачи
-            // Красноватый с градиентом
-            int intensity = (int)(m_glowIntensity * 80);
-            bgColor = QString("qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-                              "stop:0 rgb(%1,%2,%3), "
-                              "stop:0.5 rgb(%4,%5,%6), "
-                              "stop:1 rgb(%7,%8,%9))")
-                          .arg(255).arg(200 + intensity / 2).arg(200 + intensity / 2)
-                          .arg(255).arg(180 + intensity / 2).arg(180 + intensity / 2)
-                          .arg(255).arg(200 + intensity / 2).arg(200 + intensity / 2);
-            textColor = "#5D0000";
-            borderColor = "#FF8A80";
-            startGlowAnimation(days);
-            targetIntensity = 4;
-
-        } else if (days == 0) {
-            // Уровень 3: дедлайн сегодня
-            // Оранжевый
-            int intensity = (int)(m_glowIntensity * 60);
-            bgColor = QString("qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-                              "stop:0 rgb(255,%1,180), "
-                              "stop:1 rgb(255,%2,200))")
-                          .arg(220 + intensity / 2)
-                          .arg(200 + intensity / 2);
-            textColor = "#E65100";
-            borderColor = "#FFAB91";
-            startGlowAnimation(days);
-            targetIntensity = 3;
-
-        } else if (days == 1) {
-            // Уровень 2: дедлайн завтра
-            // Светло-оранжевый
-            int intensity = (int)(m_glowIntensity * 40);
-            bgColor = QString("qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-                              "stop:0 rgb(255,%1,200), "
-                              "stop:1 rgb(255,%2,210))")
-                          .arg(230 + intensity / 2)
-                          .arg(220 + intensity / 2);
-            textColor = "#EF6C00";
-            borderColor = "#FFCC80";
-            startGlowAnimation(days);
-            targetIntensity = 2;
-
-        } else if (days <= 3) {
-            // Уровень 1: дедлайн через 2-3 дня
-            // Желтоватый
-            int intensity = (int)(m_glowIntensity * 30);
-            bgColor = QString("rgb(255,%1,210)").arg(240 + intensity / 3);
-            textColor = "#F57C00";
-            borderColor = "#FFE082";
-            startGlowAnimation(days);
-            targetIntensity = 1;
+        switch (newUrgency) {
+        case CardUrgency::Overdue:  targetIntensity = 4; break; // Просроченные задачи
+        case CardUrgency::Today:    targetIntensity = 3; break; // Дедлайн сегодня
+        case CardUrgency::Tomorrow: targetIntensity = 2; break; // Дедлайн завтра
+        case CardUrgency::Soon:     targetIntensity = 1; break; // Дедлайн через 2-3 дня
+        default:                    targetIntensity = 0; break; // Нет срочности
+        }
 
+        if (targetIntensity > 0) {
+            startGlowAnimation(days);
         } else {
-            // Уровень 0: нет срочности
-            // Персиковый базовый
-            bgColor = "#FFF3E0";
-            textColor = "#333";
-            borderColor = "#FFE0B2";
             stopGlowAnimation();
-            targetIntensity = 0;
         }
 
         // Обновляем частицы только если изменились дни до дедлайна
@@ -267,194 +218,165 @@ void TaskCard::updateCardColor() {
         stopParticles();
     }
 
-    if (task->getStatus() == TaskStatus::Done) {
-        // Зеленоватый для завершенных
-        bgColor = "#E8F5E9";
-        textColor = "#1B5E20";
-        borderColor = "#A5D6A7";
-        stopGlowAnimation();
-        stopParticles();
+    if (newUrgency != urgency || !styleApplied) {
+        urgency = newUrgency;
+        styleApplied = true;
+        // Цвет текста - через стили (наследуется метками); фон и рамку рисует paintEvent
+        setStyleSheet(QString("TaskCard { "
+                              "color: %1; " // Цвет текста
+                              "} "
+                              "QLabel { "
+                              "background: transparent; " // Прозрачный фон у меток
+                              "}")
+                          .arg(cardColors(urgency).text.name()));
     }
-
-    // Применение стилей CSS ко всей карточке и ее элементам
-    setStyleSheet(QString("TaskCard { "
-                          "background: %1; "
-                          "color: %2; " // Цвет текста
-                          "border: 2px solid %3; "
-                          "border-radius: 12px; " // Скругленные углы
-                          "} "
-                          "QLabel { "
-                          "background: transparent; " // Прозрачный фон у меток
-                          "}")
-                      .arg(bgColor, textColor, borderColor));
+    update();
 }
 
 // Запуск анимации свечения с параметрами в зависимости от срочности
 void TaskCard::startGlowAnimation(int daysUntilDeadline) {
-    if (glowAnimation->state() == QAbstractAnimation::Running) {
+    if (glowActive) {
         return;
     }
 
     // Просроченные задачи: медленное пульсирующее свечение
     if (daysUntilDeadline < 0) {
-        glowAnimation->setDuration(2000); // 2 секунды на цикл
-        glowAnimation->setKeyValueAt(0, 0.3); // Начальная интенсивность: 30%
-        glowAnimation->setKeyValueAt(0.5, 1.0); // Пик: 100%
-        glowAnimation->setKeyValueAt(1, 0.3); // Конец: 30%
-    // Дедлайн сегодня: быстрое пульсирование    
+        glowDurationMs = 2000; // 2 секунды на цикл
+        glowLow = 0.3; // Начальная интенсивность: 30%
+        glowHigh = 1.0; // Пик: 100%
+    // Дедлайн сегодня: быстрое пульсирование
     } else if (daysUntilDeadline == 0) {
-        glowAnimation->setDuration(800);
-        glowAnimation->setKeyValueAt(0, 0.5);
-        glowAnimation->setKeyValueAt(0.5, 1.0);
-        glowAnimation->setKeyValueAt(1, 0.5);
-     // Дедлайн завтра: средняя скорость    
+        glowDurationMs = 800;
+        glowLow = 0.5;
+        glowHigh = 1.0;
+     // Дедлайн завтра: средняя скорость
     } else if (daysUntilDeadline == 1) {
-        glowAnimation->setDuration(1200);
-        glowAnimation->setKeyValueAt(0, 0.2);
-        glowAnimation->setKeyValueAt(0.5, 0.8);
-        glowAnimation->setKeyValueAt(1, 0.2);
-    // Дедлайн через 2-3 дня: плавное появление/исчезновение    
+        glowDurationMs = 1200;
+        glowLow = 0.2;
+        glowHigh = 0.8;
+    // Дедлайн через 2-3 дня: плавное появление/исчезновение
     } else {
-        glowAnimation->setDuration(1500);
-        glowAnimation->setKeyValueAt(0, 0.0);
-        glowAnimation->setKeyValueAt(0.5, 0.5);
-        glowAnimation->setKeyValueAt(1, 0.0);
+        glowDurationMs = 1500;
+        glowLow = 0.0;
+        glowHigh = 0.5;
     }
 
-    glowAnimation->start();
+    glowActive = true;
+    glowStartMs = AnimationClock::instance()->now();
+    updateClockRegistration();
 }
 
 void TaskCard::stopGlowAnimation() {
-    if (glowAnimation->state() == QAbstractAnimation::Running) {
-        glowAnimation->stop();
+    if (glowActive) {
+        glowActive = false;
         m_glowIntensity = 0.0;
+        updateClockRegistration();
     }
 }
 
-// Запуск эффекта частиц с заданной интенсивностью
-void TaskCard::startParticles(int intensity) {
-    if (particleIntensity == intensity && particleTimer->isActive()) {
-        return;
-    }
-
-    particleIntensity = intensity;
+void TaskCard::updateClockRegistration() {
+    // Невидимая карточка снимается с часов полностью: фаза свечения считается от времени часов,
+    // поэтому после возобновления она продолжится с правильного места
+    updateParticleDemand();
 
-    if (particleTimer->isActive()) {
-        particleTimer->stop();
-        particles.clear();
+    AnimationClock* clock = AnimationClock::instance();
+    if ((glowActive || !particles.isEmpty()) && effectsVisible()) {
+        clock->registerClient(this);
+    } else {
+        clock->unregisterClient(this);
     }
-
-    generateParticles();
-    particleTimer->start(50);
 }
 
-void TaskCard::stopParticles() {
-    particleIntensity = 0;
-    particleTimer->stop();
-    particles.clear();
-    update(); // Перерисовка виджета
+// Частицы запрашиваются из общего бюджета только у видимых карточек
+void TaskCard::updateParticleDemand() {
+    EffectsGovernor::instance().setDemand(this, effectsVisible() ? particleIntensity : 0);
 }
 
-void TaskCard::generateParticles() {
-    particles.clear();
-
-    int count = particleIntensity * 40;
-
-    // Ограничиваем область генерации нижними 30% карточки
-    qreal particleAreaHeight = height() * 0.3;
-    qreal particleAreaTop = height() - particleAreaHeight; // Начало области
-
-    for (int i = 0; i < count; i++) {
-        Particle p;
+bool TaskCard::effectsVisible() const {
+    return exposed && isVisible() && !window()->isMinimized();
+}
 
-        // Генерируем позицию с учетом скругленных углов
-        QPointF position;
-        bool validPosition = false;
-        int attempts = 0;
+bool TaskCard::isAnimating() const {
+    return AnimationClock::instance()->isRegistered(const_cast<TaskCard*>(this));
+}
 
-        while (!validPosition && attempts < 10) { // Пытаемся найти валидную позицию
-            position = QPointF(
-                QRandomGenerator::global()->generateDouble() * width(), // Случайный X
-                particleAreaTop + QRandomGenerator::global()->generateDouble() * particleAreaHeight // Случайный Y
-                );
+void TaskCard::setExposed(bool isExposed) {
+    if (exposed != isExposed) {
+        exposed = isExposed;
+        updateClockRegistration();
+    }
+}
 
-            // Проверяем, не попадает ли частица в скругленные углы
-            qreal cornerRadius = 12.0;
+void TaskCard::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    updateClockRegistration();
+}
 
-            // Расстояние от частицы до каждого угла
-            qreal distToTopLeft = QLineF(position, QPointF(0, 0)).length();
-            qreal distToTopRight = QLineF(position, QPointF(width(), 0)).length();
-            qreal distToBottomLeft = QLineF(position, QPointF(0, height())).length();
-            qreal distToBottomRight = QLineF(position, QPointF(width(), height())).length();
+void TaskCard::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    updateClockRegistration();
+}
 
-            // Если позиция в углу и слишком близко к краю - пропускаем
-            bool inTopLeft = position.x() < cornerRadius && position.y() < cornerRadius && distToTopLeft < cornerRadius;
-            bool inTopRight = position.x() > width() - cornerRadius && position.y() < cornerRadius && distToTopRight < cornerRadius;
-            bool inBottomLeft = position.x() < cornerRadius && position.y() > height() - cornerRadius && distToBottomLeft < cornerRadius;
-            bool inBottomRight = position.x() > width() - cornerRadius && position.y() > height() - cornerRadius && distToBottomRight < cornerRadius;
+// Тик общих часов: свечение и частицы продвигаются за один проход, перерисовка одна на кадр
+void TaskCard::advanceAnimation(qint64 nowMs, qreal deltaMs) {
+    if (glowActive) {
+        // Как у прежней QPropertyAnimation: кривая InOutSine применяется ко всему циклу,
+        // затем значение интерполируется по ключам low (0) -> high (0.5) -> low (1)
+        qreal progress = qreal((nowMs - glowStartMs) % glowDurationMs) / glowDurationMs;
+        qreal eased = -0.5 * (qCos(M_PI * progress) - 1.0);
+        qreal value = eased < 0.5
+            ? glowLow + (glowHigh - glowLow) * (eased / 0.5)
+            : glowHigh - (glowHigh - glowLow) * ((eased - 0.5) / 0.5);
+        setGlowIntensity(value);
+    }
 
-            if (!inTopLeft && !inTopRight && !inBottomLeft && !inBottomRight) {
-                validPosition = true;
-            }
-            attempts++;
-        }
+    // Бюджет эффектов перераспределил частицы - генерируем заново под новую долю
+    EffectsGovernor& governor = EffectsGovernor::instance();
+    if (particleIntensity > 0 && particleVersion != governor.allocationVersion(particleIntensity)) {
+        generateParticles();
+        updateClockRegistration();
+        update();
+    }
 
-        if (!validPosition) continue; // Пропускаем эту частицу
-
-        // Установка параметров частицы
-        p.position = position;
-        p.opacity = 0.4 + QRandomGenerator::global()->generateDouble() * 0.6; // Прозрачность
-        p.size = 3.0 + QRandomGenerator::global()->generateDouble() * 4.0;
-        p.velocity = 0.3 + QRandomGenerator::global()->generateDouble() * 1.2;
-
-        // Настройка цвета частиц в зависимости от интенсивности
-        if (particleIntensity == 4) {
-            p.color = QColor(
-                QRandomGenerator::global()->bounded(80, 120), 
-                QRandomGenerator::global()->bounded(20, 40),
-                QRandomGenerator::global()->bounded(10, 25)
-                );
-            p.size = 4.0 + QRandomGenerator::global()->generateDouble() * 3.0;
-            p.velocity = 0.1 + QRandomGenerator::global()->generateDouble() * 0.3;
-            p.opacity = 0.3 + QRandomGenerator::global()->generateDouble() * 0.5;
-        } else if (particleIntensity == 3) {
-            p.color = QColor(255, QRandomGenerator::global()->bounded(40, 120), 0);
-        } else if (particleIntensity == 2) {
-            p.color = QColor(255, QRandomGenerator::global()->bounded(140, 255), QRandomGenerator::global()->bounded(0, 50));
-        } else {
-            p.color = QColor(255, QRandomGenerator::global()->bounded(120, 220), QRandomGenerator::global()->bounded(20, 60));
+    if (!particles.isEmpty()) {
+        // При перегрузке частицы шагают реже, но на накопленное время - скорость не меняется
+        particleDeltaMs += deltaMs;
+        if (++particleTick % governor.particleStride() == 0) {
+            updateParticles(particleDeltaMs / 50.0); // Скорости частиц заданы на прежний тик 50 мс
+            particleDeltaMs = 0;
         }
+    }
+}
 
-        particles.append(p); // Добавление частицы в массив
+// Запуск эффекта частиц с заданной интенсивностью
+void TaskCard::startParticles(int intensity) {
+    if (particleIntensity == intensity && !particles.isEmpty()) {
+        return;
     }
+
+    particleIntensity = intensity;
+    updateParticleDemand(); // Сначала запрос, чтобы доля учитывала эту карточку
+    generateParticles();
+    updateClockRegistration();
 }
 
-// Обновление анимации части
-void TaskCard::updateParticles() {
-    for (Particle& p : particles) {
-        p.position.setY(p.position.y() - p.velocity);
-        p.position.setX(p.position.x() + (QRandomGenerator::global()->generateDouble() - 0.5) * 0.5);
-        p.opacity -= 0.015; // Постепенное исчезновение
-
-        // Если частица вышла за пределы видимости или исчезла - регенерируем ее
-        if (p.position.y() < -10 || p.opacity <= 0 || p.position.x() < 0 || p.position.x() > width()) {
-            // Регенерируем частицу в безопасной зоне (не в углах)
-            qreal x = QRandomGenerator::global()->generateDouble() * width();
-            qreal cornerRadius = 12.0;
-
-            // Избегаем нижних углов при регенерации
-            if (x < cornerRadius) {
-                x = cornerRadius + 5;
-            } else if (x > width() - cornerRadius) {
-                x = width() - cornerRadius - 5;
-            }
+void TaskCard::stopParticles() {
+    particleIntensity = 0;
+    particles.clear();
+    updateClockRegistration();
+    update(); // Перерисовка виджета
+}
 
-            p.position = QPointF(x, height() + 5); // Сразу под карточкой
-            p.opacity = 0.6 + QRandomGenerator::global()->generateDouble() * 0.4;
-            p.velocity = 0.3 + QRandomGenerator::global()->generateDouble() * 1.2;
-        }
-    }
+void TaskCard::generateParticles() {
+    EffectsGovernor& governor = EffectsGovernor::instance();
+    particles.generate(particleIntensity, width(), height(), governor.particleAllowance(particleIntensity));
+    particleVersion = governor.allocationVersion(particleIntensity);
+    particleDeltaMs = 0;
+}
 
+// Обновление анимации частиц
+void TaskCard::updateParticles(qreal step) {
+    particles.step(step, width(), height());
     update(); // Перерисовка виджета
 }
 
@@ -462,42 +384,54 @@ void TaskCard::updateParticles() {
 void TaskCard::paintEvent(QPaintEvent* event) {
     QWidget::paintEvent(event);
 
-    if (particles.isEmpty()) return;
-
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing); // Сглаживание для плавных краев
 
-    // Обрезаем рисование по скругленным углам карточки
-    QPainterPath path;
-    path.addRoundedRect(rect(), 12, 12); // Прямоугольник со скруглением 12px
-    painter.setClipPath(path); // Установка области отсечения
-
-    // Рисование каждой частицы
-    for (const Particle& p : particles) {
-        QColor color = p.color;
-        color.setAlphaF(p.opacity);
-
-        // Создание радиального градиента для эффекта размытости
-        QRadialGradient gradient(p.position, p.size * 1.5); // Центр и радиус градиента
-        gradient.setColorAt(0, color); // Центр - полный цвет
-        QColor fadeColor = color;
-        fadeColor.setAlphaF(p.opacity * 0.3);
-        gradient.setColorAt(0.6, fadeColor); // Средняя часть - полупрозрачная
-        fadeColor.setAlphaF(0);
-        gradient.setColorAt(1, fadeColor);
-
-        painter.setBrush(gradient); // Установка градиента как кисти
-        painter.setPen(Qt::NoPen); // Без контура
-        painter.drawEllipse(p.position, p.size * 1.5, p.size * 1.5);
+    // Контуры карточки пересчитываются только при смене размера
+    if (clipPathSize != size()) {
+        clipPath = QPainterPath();
+        clipPath.addRoundedRect(rect(), 12, 12); // Прямоугольник со скруглением 12px
+        borderPath = QPainterPath();
+        borderPath.addRoundedRect(QRectF(rect()).adjusted(1, 1, -1, -1), 11, 11); // Рамка 2px внутри карточки
+        clipPathSize = size();
     }
+
+    // Фон со свечением и рамка (раньше - через таблицу стилей на каждом кадре)
+    painter.setPen(QPen(cardColors(urgency).border, 2));
+    painter.setBrush(cardBackground(urgency, m_glowIntensity));
+    painter.drawPath(borderPath);
+
+    if (particles.isEmpty()) return;
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform); // Дробные позиции частиц
+    painter.setClipPath(clipPath); // Установка области отсечения
+
+    // Каждая частица - копия готовой мягкой точки из атласа с прозрачностью частицы
+    const ParticleAtlas::Sheet& sheet = ParticleAtlas::sheet(particles.intensity(), devicePixelRatioF());
+    const float* xs = particles.x();
+    const float* ys = particles.y();
+    const float* opacities = particles.opacity();
+    const quint8* sprites = particles.sprite();
+
+    fragments.resize(particles.size()); // Буфер карточки: без выделения памяти на каждом кадре
+    for (int i = 0; i < particles.size(); i++) {
+        const QRectF& source = sheet.sources[sprites[i]];
+        fragments[i] = QPainter::PixmapFragment::create(QPointF(xs[i], ys[i]), source,
+                                                        sheet.scale, sheet.scale, 0,
+                                                        qBound(0.0f, opacities[i], 1.0f));
+    }
+    painter.drawPixmapFragments(fragments.constData(), fragments.size(), sheet.pixmap);
 }
 
 // Получение текста для кнопки статуса
 QString TaskCard::getStatusButtonText() const {
     if (!task) return "";
+    return statusButtonText(task->getStatus());
+}
 
+QString TaskCard::statusButtonText(TaskStatus status) {
     // Преобразование статуса задачи в текст кнопки
-    switch (task->getStatus()) { 
+    switch (status) { 
     case TaskStatus::Backlog:
         return "→ Назначить";
     case TaskStatus::Assigned:
@@ -513,19 +447,39 @@ QString TaskCard::getStatusButtonText() const {
     }
 }
 
+QString TaskCard::deadlineText(const Task& task) {
+    if (!task.hasDeadline()) return "";
+
+    const QDateTime now = QDateTime::currentDateTime();
+    int days = task.daysUntilDeadline(now);
+    if (task.isOverdue(now)) {
+        return QString("🔥 Просрочено на %1 дн.").arg(-days);
+    } else if (days == 0) {
+        return "🔥 Дедлайн сегодня!";
+    } else if (days == 1) {
+        return "⚠️ Дедлайн завтра";
+    }
+    return QString("📅 Дедлайн: %1 дн.").arg(days);
+}
+
 // Получение имени разработчика для отображения
 QString TaskCard::getDeveloperName() const {
-    if (!task || !board || !task->isAssigned()) {
+    if (!task) return "Не назначена";
+    return developerName(*task, board);
+}
+
+QString TaskCard::developerName(const Task& task, Board* board) {
+    if (!board || !task.isAssigned()) {
         return "Не назначена";
     }
 
     // Получение объекта разработчика по ID из доски
-    Developer* dev = board->getDeveloper(task->getAssignedDeveloperId());
+    Developer* dev = board->getDeveloper(task.getAssignedDeveloperId());
     if (dev) {
         return dev->getName();
     }
 
-    return QString("ID: %1").arg(task->getAssignedDeveloperId());
+    return QString("ID: %1").arg(task.getAssignedDeveloperId());
 }
 
 // Обработка нажатия кнопки мыши
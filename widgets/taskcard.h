@@ -7,23 +7,17 @@
 #include <QVBoxLayout>
 #include <QMouseEvent> // Обработка кликов и перемещения мыши
 #include <QDrag>
-#include <QPropertyAnimation> // Анимация свойств
 #include <QGraphicsOpacityEffect> // Эффект прозрачности для виджетов
-#include <QTimer>
 #include <QPainter>
-#include <QVector> // Контейнер для хранения частиц
+#include <QPainterPath>
+#include <QVector>
 #include "../models/task.h"
 #include "../models/board.h"
+#include "animationclock.h"
+#include "particlesystem.h"
+#include "cardstyle.h"
 
-struct Particle { // Структура для частиц визуальных эффектов
-    QPointF position;
-    qreal opacity;
-    qreal size;
-    qreal velocity;
-    QColor color;
-};
-
-class TaskCard : public QWidget { //Визуальная карточка задачи
+class TaskCard : public QWidget, private AnimationClient { //Визуальная карточка задачи
     Q_OBJECT
     // glowIntensity - интенсивность свечения карточки
     Q_PROPERTY(qreal glowIntensity READ glowIntensity WRITE setGlowIntensity) 
@@ -32,9 +26,20 @@ public:
     // task - указатель на объект задачи
     // board - указатель на доску
     explicit TaskCard(Task* task, Board* board, QWidget* parent = nullptr);
+    ~TaskCard() override;
 
     Task* getTask() const { return task; }
     void updateDisplay();
+    void rebind(Task* newTask); // Привязать карточку к другой задаче (nullptr - отвязать, для пула)
+
+    // Видна ли карточка в области прокрутки колонки; вне экрана эффекты приостановлены
+    void setExposed(bool isExposed);
+    bool isAnimating() const; // Подписана ли карточка на часы анимации прямо сейчас
+
+    // Тексты карточки (общие с делегатом виртуализированной колонки)
+    static QString statusButtonText(TaskStatus status);
+    static QString deadlineText(const Task& task); // Пустая строка, если дедлайна нет
+    static QString developerName(const Task& task, Board* board);
 
     qreal glowIntensity() const { return m_glowIntensity; }
     void setGlowIntensity(qreal intensity);
@@ -48,9 +53,8 @@ protected:
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void paintEvent(QPaintEvent* event) override; // Метод отрисовки виджета
-
-private slots:
-    void updateParticles(); // Слот для обновления анимации частиц
+    void showEvent(QShowEvent* event) override; // Возобновление эффектов
+    void hideEvent(QHideEvent* event) override; // Приостановка эффектов (скрыта, свернута, другая страница)
 
 private:
     Task* task; // Задача, которую представляет эта карточка
@@ -64,12 +68,28 @@ private:
     QPushButton* statusBtn;
 
     QPoint dragStartPosition; // Позиция, с которой началось перетаскивание
-    QPropertyAnimation* glowAnimation; // Аниматор для эффекта свечения при приближении дедлайна
-    QTimer* particleTimer;
-    QVector<Particle> particles;
+
+    // Свечение считается от времени общих часов: цикл glowDurationMs, от glowLow до glowHigh и обратно
+    bool glowActive;
+    qint64 glowStartMs;
+    int glowDurationMs;
+    qreal glowLow;
+    qreal glowHigh;
+
+    ParticleSystem particles; // Частицы в виде структуры массивов с собственным генератором
+    QVector<QPainter::PixmapFragment> fragments; // Буфер отрисовки частиц из атласа
+    QPainterPath clipPath; // Скругленный контур карточки для отсечения частиц
+    QPainterPath borderPath; // Рамка карточки (внутри clipPath на полширины линии)
+    QSize clipPathSize;    // Размер, для которого построены clipPath и borderPath
     qreal m_glowIntensity;
     int particleIntensity; // 0 = нет, 1-4 = уровень интенсивности
     int lastDaysUntilDeadline; // Отслеживание изменений дедлайна для предотвращения лишней регенерации частиц
+    CardUrgency urgency; // Уровень, для которого применена таблица стилей
+    bool styleApplied;
+    bool exposed; // Пересекается с видимой частью колонки
+    quint64 particleVersion; // Версия распределения бюджета, под которую сгенерированы частицы
+    qreal particleDeltaMs;   // Время, накопленное с последнего шага частиц
+    int particleTick;
 
     void setupUI(); // Настройка пользовательского интерфейса
     void updateCardColor();
@@ -79,6 +99,11 @@ private:
     void startParticles(int intensity);
     void stopParticles();
     void generateParticles();
+    void updateParticles(qreal step); // step - доля от прежнего шага таймера частиц (50 мс)
+    void advanceAnimation(qint64 nowMs, qreal deltaMs) override; // Тик общих часов анимации
+    void updateClockRegistration(); // Подписка на часы только пока есть эффекты и карточку видно
+    bool effectsVisible() const;
+    void updateParticleDemand(); // Запрос частиц у общего бюджета эффектов
     QString getStatusButtonText() const; // Получение текста для кнопки статуса
     QString getDeveloperName() const; // Получение имени разработчика для отображения
 };
@@ -0,0 +1,157 @@
+#include "taskcarddelegate.h"
+#include "taskcard.h"
+#include "cardstyle.h"
+#include "columnmodel.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QFontMetrics>
+#include <QTimer>
+
+TaskCardDelegate::TaskCardDelegate(Board* board, QObject* parent)
+    : QStyledItemDelegate(parent), board(board) {
+}
+
+Task* TaskCardDelegate::taskFor(const QModelIndex& index) const {
+    return board->getTask(index.data(ColumnModel::TaskIdRole).toLongLong());
+}
+
+// Геометрия карточки внутри строки списка (отступы как у карточек в колонке)
+QRect TaskCardDelegate::cardRect(const QRect& itemRect) {
+    return itemRect.adjusted(5, 5, -5, -5);
+}
+
+QRect TaskCardDelegate::statusButtonRect(const QRect& itemRect) {
+    QRect card = cardRect(itemRect);
+    return QRect(card.left() + 10, card.bottom() - 38, card.width() - 20 - 2 * 35, 28);
+}
+
+QRect TaskCardDelegate::editButtonRect(const QRect& itemRect) {
+    QRect status = statusButtonRect(itemRect);
+    return QRect(status.right() + 5, status.top(), 30, status.height());
+}
+
+QRect TaskCardDelegate::deleteButtonRect(const QRect& itemRect) {
+    QRect edit = editButtonRect(itemRect);
+    return QRect(edit.right() + 5, edit.top(), 30, edit.height());
+}
+
+void TaskCardDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    Task* task = taskFor(index);
+    if (!task) return;
+
+    CardColors colors = cardColors(cardUrgency(*task));
+    QRect card = cardRect(option.rect);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    // Фон и рамка карточки
+    painter->setPen(QPen(colors.border, 2));
+    painter->setBrush(colors.background);
+    painter->drawRoundedRect(QRectF(card).adjusted(1, 1, -1, -1), 12, 12);
+
+    QRect content = card.adjusted(10, 10, -10, -10);
+    painter->setPen(colors.text);
+
+    // Название (жирным, до двух строк)
+    QFont titleFont = option.font;
+    titleFont.setBold(true);
+    titleFont.setPointSize(11);
+    painter->setFont(titleFont);
+    QFontMetrics titleMetrics(titleFont);
+    QRect titleRect(content.left(), content.top(), content.width(), titleMetrics.height() * 2);
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap, task->getTitle());
+
+    // Описание (фиксированная высота, как у TaskCard)
+    QFont textFont = option.font;
+    painter->setFont(textFont);
+    QRect descRect(content.left(), titleRect.bottom() + 5, content.width(), 40);
+    QString desc = task->getDescription().isEmpty() ? QString("Нет описания") : task->getDescription();
+    painter->drawText(descRect, Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap, desc);
+
+    QFontMetrics textMetrics(textFont);
+    int lineTop = descRect.bottom() + 5;
+
+    // Дедлайн
+    QString deadline = TaskCard::deadlineText(*task);
+    if (!deadline.isEmpty()) {
+        QFont deadlineFont = textFont;
+        deadlineFont.setBold(true);
+        painter->setFont(deadlineFont);
+        painter->drawText(QRect(content.left(), lineTop, content.width(), textMetrics.height()),
+                          Qt::AlignLeft, deadline);
+        lineTop += textMetrics.height() + 5;
+    }
+
+    // Разработчик
+    QFont assignedFont = textFont;
+    assignedFont.setItalic(true);
+    painter->setFont(assignedFont);
+    QString assigned = task->isAssigned()
+        ? QString("👤 %1").arg(TaskCard::developerName(*task, board))
+        : QString("⚠️ Не назначена");
+    painter->drawText(QRect(content.left(), lineTop, content.width(), textMetrics.height()),
+                      Qt::AlignLeft, textMetrics.elidedText(assigned, Qt::ElideRight, content.width()));
+
+    // Кнопки: статус, редактирование, удаление
+    painter->setFont(textFont);
+    painter->setPen(Qt::NoPen);
+
+    painter->setBrush(QColor("#4CAF50"));
+    painter->drawRect(statusButtonRect(option.rect));
+    painter->setBrush(QColor("#E0E0E0"));
+    painter->drawRect(editButtonRect(option.rect));
+    painter->setBrush(QColor("#f44336"));
+    painter->drawRect(deleteButtonRect(option.rect));
+
+    painter->setPen(Qt::white);
+    painter->drawText(statusButtonRect(option.rect), Qt::AlignCenter, TaskCard::statusButtonText(task->getStatus()));
+    painter->setPen(Qt::black);
+    painter->drawText(editButtonRect(option.rect), Qt::AlignCenter, "✏️");
+    painter->setPen(Qt::white);
+    painter->drawText(deleteButtonRect(option.rect), Qt::AlignCenter, "🗑️");
+
+    painter->restore();
+}
+
+QSize TaskCardDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+    return QSize(200, CardHeight); // Одинаковая высота строк - QListView не измеряет каждую
+}
+
+bool TaskCardDelegate::editorEvent(QEvent* event, QAbstractItemModel* model,
+                                   const QStyleOptionViewItem& option, const QModelIndex& index) {
+    if (event->type() == QEvent::MouseButtonRelease) {
+        QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+        Task* task = taskFor(index);
+        if (task && mouseEvent->button() == Qt::LeftButton) {
+            QPoint pos = mouseEvent->pos();
+            TaskId taskId = task->getId();
+            // Сигналы отправляем после выхода из обработчика: слоты открывают диалоги
+            // и сбрасывают модель, что нельзя делать посреди события представления
+            auto emitLater = [this, taskId](void (TaskCardDelegate::*signal)(Task*)) {
+                QTimer::singleShot(0, this, [this, taskId, signal]() {
+                    Task* current = board->getTask(taskId);
+                    if (current) {
+                        emit (this->*signal)(current);
+                    }
+                });
+            };
+
+            if (statusButtonRect(option.rect).contains(pos)) {
+                emitLater(&TaskCardDelegate::statusChangeClicked);
+                return true;
+            }
+            if (editButtonRect(option.rect).contains(pos)) {
+                emitLater(&TaskCardDelegate::editClicked);
+                return true;
+            }
+            if (deleteButtonRect(option.rect).contains(pos)) {
+                emitLater(&TaskCardDelegate::deleteClicked);
+                return true;
+            }
+        }
+    }
+    return QStyledItemDelegate::editorEvent(event, model, option, index);
+}
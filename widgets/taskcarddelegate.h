@@ -0,0 +1,40 @@
+#ifndef TASKCARDDELEGATE_H
+#define TASKCARDDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include "../models/board.h"
+
+// Рисует карточку задачи прямо в QListView: отрисовываются только строки в области
+// видимости, без отдельного виджета на задачу. Кнопки обрабатываются через editorEvent.
+class TaskCardDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    explicit TaskCardDelegate(Board* board, QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+signals:
+    // Те же сигналы, что у TaskCard
+    void editClicked(Task* task);
+    void deleteClicked(Task* task);
+    void statusChangeClicked(Task* task);
+
+protected:
+    bool editorEvent(QEvent* event, QAbstractItemModel* model,
+                     const QStyleOptionViewItem& option, const QModelIndex& index) override;
+
+private:
+    Board* board;
+
+    static const int CardHeight = 190;
+
+    Task* taskFor(const QModelIndex& index) const;
+    static QRect cardRect(const QRect& itemRect);
+    static QRect statusButtonRect(const QRect& itemRect);
+    static QRect editButtonRect(const QRect& itemRect);
+    static QRect deleteButtonRect(const QRect& itemRect);
+};
+
+#endif // TASKCARDDELEGATE_H
@@ -0,0 +1,52 @@
+#include "taskcardpool.h"
+
+TaskCardPool::TaskCardPool(Factory factory, int maxIdle)
+    : factory(std::move(factory)), idleLimit(qMax(0, maxIdle)) {
+}
+
+TaskCardPool::~TaskCardPool() {
+    clear();
+}
+
+TaskCard* TaskCardPool::acquire(Task* task) {
+    if (!idle.isEmpty()) {
+        TaskCard* card = idle.takeLast(); // Последняя возвращенная - скорее всего еще в кэше
+        card->rebind(task);
+        hitCount++;
+        return card;
+    }
+
+    missCount++;
+    return factory(task);
+}
+
+void TaskCardPool::release(TaskCard* card) {
+    if (!card) return;
+
+    card->hide();
+    card->rebind(nullptr); // Останавливает анимации и частицы
+
+    if (idle.size() >= idleLimit) {
+        card->deleteLater(); // Сигнал мог прийти от самой карточки
+        return;
+    }
+    idle.append(card);
+}
+
+void TaskCardPool::clear() {
+    for (TaskCard* card : idle) {
+        card->deleteLater();
+    }
+    idle.clear();
+}
+
+void TaskCardPool::setMaxIdle(int count) {
+    idleLimit = qMax(0, count);
+    trim();
+}
+
+void TaskCardPool::trim() {
+    while (idle.size() > idleLimit) {
+        idle.takeLast()->deleteLater();
+    }
+}
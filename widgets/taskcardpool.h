@@ -0,0 +1,43 @@
+#ifndef TASKCARDPOOL_H
+#define TASKCARDPOOL_H
+
+#include <QVector>
+#include <functional>
+#include "taskcard.h"
+
+// Пул переиспользуемых карточек: вместо delete/new карточка отвязывается от задачи
+// и при следующем запросе привязывается к другой (rebind + updateDisplay).
+// Создание карточки дорогое: семь дочерних виджетов (метки и кнопки) с двумя компоновками,
+// таблицы стилей кнопок и подключение сигналов. Анимация и фон карточки от этого не зависят:
+// они идут от общих часов и рисуются в paintEvent.
+class TaskCardPool {
+public:
+    using Factory = std::function<TaskCard*(Task*)>; // Создает новую карточку с подключенными сигналами
+
+    explicit TaskCardPool(Factory factory, int maxIdle = 64);
+    ~TaskCardPool();
+
+    TaskCard* acquire(Task* task); // Карточка из пула или новая, если пул пуст
+    void release(TaskCard* card);  // Вернуть карточку; сверх лимита карточка удаляется
+    void clear();                  // Удалить все свободные карточки
+
+    void setMaxIdle(int count);
+    int maxIdle() const { return idleLimit; }
+    int idleCount() const { return idle.size(); }
+
+    // Счетчики для диагностики: сколько запросов обслужено из пула и сколько потребовали создания
+    int hits() const { return hitCount; }
+    int misses() const { return missCount; }
+    void resetCounters() { hitCount = 0; missCount = 0; }
+
+private:
+    Factory factory;
+    QVector<TaskCard*> idle; // Свободные карточки (скрыты, не привязаны к задаче)
+    int idleLimit;
+    int hitCount = 0;
+    int missCount = 0;
+
+    void trim(); // Удалить лишние свободные карточки сверх лимита
+};
+
+#endif // TASKCARDPOOL_H